@@ -15,6 +15,13 @@ function Skip(){
   return 1
 }
 
+# Derive the random seed of one simulation process from the run seed. The same run seed and
+# process index always give the same seed, so two runs with the same run seed see the same
+# random sequences (common random numbers), while the processes of one run are uncorrelated.
+function DeriveSeed(){
+  echo $(( ($1 * 2654435761 + ($2 + 1) * 2246822519) % 2147483647 ))
+}
+
 function RunTest(){
   # Set default values
   arg_ch=""
@@ -45,6 +52,8 @@ function RunTest(){
   # print source files directory name relative to zephyr base without leading slash and with slashes replaced by underscores
   SCRIPT_PATH="$(cd -- "$(dirname -- "${BASH_SOURCE[0]}")" &> /dev/null && pwd)/$(basename -- "${BASH_SOURCE[0]}")"
   APP_DIR="$(dirname "$SCRIPT_PATH")"
+  SRC_DIR="${APP_DIR}"
+  LAUNCHER="${APP_DIR}/helper_sim_launcher.py"
   APP_DIR="${APP_DIR/${ZEPHYR_BASE}/}"
   APP_DIR="${APP_DIR//\//_}" # Replace slashes with underscores
 
@@ -58,6 +67,11 @@ function RunTest(){
 
   cd ${BSIM_OUT_PATH}/bin
 
+  # Without RUN_SEED the devices and the phy use their default seeds
+  if [[ -n "${RUN_SEED:-}" ]]; then
+    echo "Run seed: ${RUN_SEED}"
+  fi
+
   idx=0
 
   s_id=$1
@@ -66,6 +80,7 @@ function RunTest(){
   declare -A testids
   testid=""
   testid_in_order=()
+  dev_cmds=()
 
   for arg in $@ ; do
     if [ "$arg" == "--" ]; then
@@ -102,24 +117,87 @@ function RunTest(){
         exe_name=./bs_${BOARD_TS}_${APP_DIR}_${conf}
     fi
 
-    Execute \
-      ${exe_name} \
-      -v=${verbosity_level} -s=$s_id -d=$idx -sync_preboot -RealEncryption=1 \
-      -testid=$testid ${testids["${testid}"]} ${test_options}
+    seed_arg=${RUN_SEED:+-rs=$(DeriveSeed ${RUN_SEED} $idx)}
+    dev_cmds+=(--dev "${exe_name} \
+      -v=${verbosity_level} -s=$s_id -d=$idx -sync_preboot -RealEncryption=1 ${seed_arg} \
+      -testid=$testid ${testids["${testid}"]} ${test_options}")
     let idx=idx+1
   done
 
+  # Fill the spare phy slots with EXTRA_DEVS_TESTID (e.g. background interferers), if given.
+  # Otherwise the slots are left free for devices started outside of this script.
+  if [[ -n "${EXTRA_DEVS_TESTID:-}" ]]; then
+    for ((i = 0; i < extra_devs; i++)); do
+      echo "Starting ${EXTRA_DEVS_TESTID} as device #$idx"
+      seed_arg=${RUN_SEED:+-rs=$(DeriveSeed ${RUN_SEED} $idx)}
+      dev_cmds+=(--dev "${exe_name} \
+        -v=${verbosity_level} -s=$s_id -d=$idx -sync_preboot -RealEncryption=1 ${seed_arg} \
+        -testid=${EXTRA_DEVS_TESTID} ${test_options}")
+      let idx=idx+1
+    done
+    extra_devs=0
+  fi
+
   count=$(expr $idx + $extra_devs)
 
   echo "Starting phy with $count devices"
 
+  # The phy seed is derived past the last device index
+  phy_seed_arg=${RUN_SEED:+-rs=$(DeriveSeed ${RUN_SEED} $count)}
+
   if [[ "$arg_ch" == "multiatt" ]]; then
-    Execute ./bs_2G4_phy_v1 -v=${verbosity_level} -s=$s_id -D=$count $use_nodump -defmodem=BLE_simple -channel=$arg_ch -argschannel -at=100 -atextra=0 -file=$arg_file
+    phy_cmd="./bs_2G4_phy_v1 -v=${verbosity_level} -s=$s_id -D=$count $use_nodump ${phy_seed_arg} -defmodem=BLE_simple -channel=$arg_ch -argschannel -at=100 -atextra=0 -file=$arg_file"
   else
-    Execute ./bs_2G4_phy_v1 -v=${verbosity_level} -s=$s_id -D=$count $use_nodump -argschannel -at=35
+    phy_cmd="./bs_2G4_phy_v1 -v=${verbosity_level} -s=$s_id -D=$count $use_nodump ${phy_seed_arg} -argschannel -at=35"
+  fi
+
+  # The launcher pins the phy to its own core and spreads the devices over the remaining
+  # ones (see helper_sim_launcher.py). SIM_CPUS, SIM_PHY_CPU and SIM_SPREAD override this.
+  launcher_args=(--timeout ${EXECUTE_TIMEOUT} --spread ${SIM_SPREAD:-cpu})
+  if [[ -n "${SIM_CPUS:-}" ]]; then
+    launcher_args+=(--cpus "${SIM_CPUS}")
+  fi
+  if [[ -n "${SIM_PHY_CPU:-}" ]]; then
+    launcher_args+=(--phy-cpu "${SIM_PHY_CPU}")
+  fi
+
+  # With RESULTS_DB set, the console output is also kept with the run results and appended to
+  # that database (see helper_results_db.py). RESULTS_LABEL tags the run, e.g. with the SDK
+  # version under test.
+  if [[ -z "${RESULTS_DB:-}" ]]; then
+    python3 "${LAUNCHER}" "${launcher_args[@]}" --phy "${phy_cmd}" "${dev_cmds[@]}"
+    if [ $? -ne 0 ]; then
+      exit 1
+    fi
+    return
+  fi
+
+  run_log="${BSIM_OUT_PATH}/results/${s_id}/run.log"
+  mkdir -p "$(dirname "${run_log}")"
+
+  python3 "${LAUNCHER}" "${launcher_args[@]}" --phy "${phy_cmd}" "${dev_cmds[@]}" \
+    2>&1 | tee "${run_log}"
+  status=${PIPESTATUS[0]}
+
+  ingest_args=(--db "${RESULTS_DB}" --simid "${s_id}" --app-dir "${SRC_DIR}" \
+    --conf "${SRC_DIR}/prj.conf" --testids "${testid_in_order[*]}" \
+    --params "${test_options}" --nodes ${idx} --status ${status})
+  # The exe suffix of overlay_x.conf is overlay_x_conf
+  if [ ${overlay} ]; then
+    ingest_args+=(--conf "${SRC_DIR}/${overlay%_conf}.conf")
+  fi
+  if [[ -n "${arg_file}" ]]; then
+    ingest_args+=(--coeff "${arg_file}")
+  fi
+  if [[ -n "${RESULTS_LABEL:-}" ]]; then
+    ingest_args+=(--label "${RESULTS_LABEL}")
   fi
 
-  wait_for_background_jobs
+  python3 "${SRC_DIR}/helper_results_db.py" ingest "${run_log}" "${ingest_args[@]}"
+
+  if [ ${status} -ne 0 ]; then
+    exit 1
+  fi
 }
 
 function RunTestFlash(){
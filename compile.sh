@@ -17,5 +17,7 @@ APP_DIR="${APP_DIR/${ZEPHYR_BASE}/}"
 echo "Compiling applications in ${APP_DIR}"
 
 app=$APP_DIR cmake_args="-DCONFIG_COVERAGE=n" compile
+app=$APP_DIR cmake_args="-DCONFIG_COVERAGE=n" conf_overlay=overlay_id_addr.conf compile
+app=$APP_DIR cmake_args="-DCONFIG_COVERAGE=n" conf_overlay=overlay_crpl_128.conf compile
 
 wait_for_background_jobs
@@ -0,0 +1,131 @@
+#!/usr/bin/env python3
+# Copyright 2025 Nordic Semiconductor
+# SPDX-License-Identifier: Apache-2.0
+
+# Paired comparison of two configurations run with the same seeds (see test_ab_paired.sh).
+#
+# Each directory holds one console log per seed, named seed_<n>.log. Latency samples of the two
+# configurations are paired on (seed, DUT, bearer, iteration) and only pairs where both probes
+# were answered are used. Runs with the same seed are the unit of the statistics: per seed the
+# mean paired difference is taken, and the confidence interval is computed over the seeds.
+# The unpaired standard error of the same data is printed for reference; its ratio to the
+# paired one shows how many more runs an unpaired comparison would have needed.
+#
+# Examples of use:
+# python3 helper_ab_compare.py ${BSIM_OUT_PATH}/results/ab_20250101_120000/A \
+#     ${BSIM_OUT_PATH}/results/ab_20250101_120000/B
+
+import argparse
+import math
+import os
+import re
+import statistics
+import sys
+
+from helper_results_db import parse_log
+
+SEED_LOG_RE = re.compile(r'seed_(\d+)\.log$')
+
+# Two-sided 95% Student t quantiles by degrees of freedom, normal approximation above 30
+T95 = [12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+       2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+       2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042]
+
+
+def t95(df):
+    return T95[df - 1] if df <= len(T95) else 1.96
+
+
+def load(directory):
+    """Map seed -> {(dev, bearer, iter): latency} of the answered probes."""
+    runs = {}
+    for name in sorted(os.listdir(directory)):
+        m = SEED_LOG_RE.search(name)
+        if not m:
+            continue
+        with open(os.path.join(directory, name), errors='replace') as f:
+            _, _, samples = parse_log(f)
+        runs[int(m.group(1))] = {(dev, bearer, it): lat
+                                 for dev, bearer, it, lat, ok in samples if ok}
+    return runs
+
+
+def mean_ci(values):
+    """Mean and 95% confidence half-width, None if it cannot be computed."""
+    n = len(values)
+    mean = statistics.fmean(values)
+    if n < 2:
+        return mean, None
+    return mean, t95(n - 1) * statistics.stdev(values) / math.sqrt(n)
+
+
+def fmt_ci(mean, half):
+    return f"{mean:+8.1f} ms" + (f" +/- {half:6.1f}" if half is not None else "    (n=1)")
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Paired A/B latency comparison over seeds")
+    parser.add_argument('a_dir', help="Logs of configuration A (seed_<n>.log)")
+    parser.add_argument('b_dir', help="Logs of configuration B (seed_<n>.log)")
+    args = parser.parse_args()
+
+    a_runs, b_runs = load(args.a_dir), load(args.b_dir)
+    seeds = sorted(set(a_runs) & set(b_runs))
+    if not seeds:
+        sys.exit("Error: no seed was run successfully in both configurations")
+
+    skipped = sorted(set(a_runs) ^ set(b_runs))
+    if skipped:
+        print(f"Seeds present in only one configuration (ignored): {skipped}")
+
+    seed_diff, seed_a, seed_b = [], [], []
+    dev_diff = {}
+    pairs = unpaired = 0
+
+    for seed in seeds:
+        a, b = a_runs[seed], b_runs[seed]
+        common = sorted(set(a) & set(b))
+        unpaired += len(set(a) ^ set(b))
+        if not common:
+            continue
+        pairs += len(common)
+
+        seed_a.append(statistics.fmean(a[k] for k in common))
+        seed_b.append(statistics.fmean(b[k] for k in common))
+        seed_diff.append(seed_b[-1] - seed_a[-1])
+
+        per_dev = {}
+        for k in common:
+            per_dev.setdefault(k[:2], []).append(b[k] - a[k])
+        for key, diffs in per_dev.items():
+            dev_diff.setdefault(key, []).append(statistics.fmean(diffs))
+
+    if not seed_diff:
+        sys.exit("Error: no answered probe pairs in common")
+
+    print(f"Paired comparison over {len(seed_diff)} seeds, {pairs} probe pairs "
+          f"({unpaired} probes without an answered counterpart)")
+    print("\nPer DUT, B - A (mean over seeds, 95% CI):")
+    for (dev, bearer), diffs in sorted(dev_diff.items()):
+        print(f"  Dev {dev:3d} {bearer:<5} {fmt_ci(*mean_ci(diffs))}")
+
+    mean, half = mean_ci(seed_diff)
+    print(f"\nMean latency A {statistics.fmean(seed_a):.1f} ms, "
+          f"B {statistics.fmean(seed_b):.1f} ms")
+    print(f"Paired difference B - A: {fmt_ci(mean, half)}")
+
+    if half is not None:
+        n = len(seed_diff)
+        se_paired = statistics.stdev(seed_diff) / math.sqrt(n)
+        se_unpaired = math.sqrt((statistics.variance(seed_a) + statistics.variance(seed_b)) / n)
+        verdict = "significant" if abs(mean) > half else "not significant"
+        print(f"The difference is {verdict} at the 95% level")
+        if se_paired > 1e-9:
+            print(f"Standard error paired {se_paired:.2f} ms, unpaired {se_unpaired:.2f} ms: "
+                  f"an unpaired comparison needs ~{(se_unpaired / se_paired) ** 2:.1f}x the runs")
+    else:
+        print("Run at least two seeds for a confidence interval")
+
+
+if __name__ == "__main__":
+    main()
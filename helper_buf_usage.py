@@ -0,0 +1,89 @@
+#!/usr/bin/env python3
+# Copyright 2025 Nordic Semiconductor
+# SPDX-License-Identifier: Apache-2.0
+
+# Shows where the advertising buffers run out first in a burst run (test_burst.sh), from its
+# console output.
+#
+# Every node logs the high-water mark, allocations and allocation failures of its local
+# (CONFIG_BT_MESH_ADV_BUF_COUNT) and relay (CONFIG_BT_MESH_RELAY_BUF_COUNT) pools, and the time
+# the first pool ran out. The tester logs when each burst size starts, so every exhaustion is
+# attributed to the burst size in progress. Nodes are listed in the order they ran out.
+#
+# Examples of use:
+# python3 helper_buf_usage.py burst.log
+# python3 helper_buf_usage.py burst.log --all
+
+import argparse
+import bisect
+import re
+import sys
+
+BUFS_RE = re.compile(r'Bufs dev (\d+): local max (\d+)/(\d+) allocs (\d+) fail (\d+), '
+                     r'relay max (\d+)/(\d+) allocs (\d+) fail (\d+), '
+                     r'first out (\w+) at (-?\d+) ms')
+PHASE_RE = re.compile(r'Burst size (\d+): from (\d+) ms')
+RESULT_RE = re.compile(r'Burst size (\d+): \d+ bursts.*p50 (\d+) ms p95 (\d+) ms, '
+                       r'queueing ([+-]\d+) ms')
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Advertising buffer exhaustion per node")
+    parser.add_argument('log', help="Console output of a burst run")
+    parser.add_argument('--all', action='store_true',
+                        help="List all nodes, not only those that ran out of buffers")
+    args = parser.parse_args()
+
+    nodes = []
+    phases = []
+    results = {}
+    with open(args.log, errors='replace') as f:
+        for line in f:
+            m = BUFS_RE.search(line)
+            if m:
+                v = [int(x) if x.lstrip('-').isdigit() else x for x in m.groups()]
+                nodes.append(v)
+                continue
+            m = PHASE_RE.search(line)
+            if m:
+                phases.append((int(m.group(2)), int(m.group(1))))
+                continue
+            m = RESULT_RE.search(line)
+            if m:
+                results[int(m.group(1))] = m.groups()[1:]
+
+    if not nodes:
+        sys.exit(f"Error: no buffer reports in {args.log} (run test_burst.sh)")
+
+    starts = [t for t, _ in phases]
+
+    def size_at(ms):
+        i = bisect.bisect_right(starts, ms)
+        return phases[i - 1][1] if i else None
+
+    if results:
+        print("Burst size  p50 [ms]  p95 [ms]  queueing vs first size [ms]")
+        for k, (p50, p95, queue) in results.items():
+            print(f"{k:>10}  {p50:>8}  {p95:>8}  {queue:>8}")
+        print()
+
+    out = sorted((n for n in nodes if n[9] != 'none'), key=lambda n: n[10])
+    print(f"{len(out)} of {len(nodes)} nodes ran out of advertising buffers")
+    rows = out + ([n for n in nodes if n[9] == 'none'] if args.all else [])
+    if rows:
+        print("   Dev  First out   at [ms]  Burst size  Local max/size  fail  Relay max/size  fail")
+    for (dev, l_max, l_size, _, l_fail, r_max, r_size, _, r_fail, first, at) in rows:
+        k = size_at(at) if at >= 0 else None
+        print(f"  {dev:4d}  {first:>9}  {at if at >= 0 else '-':>8}  {k if k else '-':>10}  "
+              f"{l_max:>9}/{l_size:<4}  {l_fail:4d}  {r_max:>9}/{r_size:<4}  {r_fail:4d}")
+
+    full = {pool: sum(1 for n in nodes if n[i] >= n[i + 1]) for pool, i in (('local', 1),
+                                                                               ('relay', 5))}
+    print(f"\nPools filled to capacity: local on {full['local']} nodes, "
+          f"relay on {full['relay']} nodes")
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
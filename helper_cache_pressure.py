@@ -0,0 +1,155 @@
+#!/usr/bin/env python3
+# Copyright 2025 Nordic Semiconductor
+# SPDX-License-Identifier: Apache-2.0
+
+# Summarizes a replay protection list (RPL) and message cache pressure sweep
+# (test_rpl_pressure.sh), from the console output of one group convergecast run per network size.
+#
+# Per network size and load phase, the table gives the sink's delivery ratio and p50/p95
+# latency, the PDUs the nodes sent and relayed per second (the airtime used), and the
+# RPL-full rejections and duplicate relays of the sources. Per network size, the totals of all
+# nodes follow: how many nodes had a full RPL or relayed messages evicted from their cache.
+# The last lines name the first size and phase where delivery, latency or airtime degraded
+# against the smallest size, next to CONFIG_BT_MESH_CRPL and CONFIG_BT_MESH_MSG_CACHE_SIZE.
+#
+# Examples of use:
+# python3 helper_cache_pressure.py results/rpl_20250101_120000/n_*.log
+# python3 helper_cache_pressure.py n_32.log n_64.log n_96.log --sat 95 --p95-factor 1.5
+
+import argparse
+import re
+import sys
+
+SINK_RE = re.compile(r'Convergecast to sink 0x[0-9a-f]+( via group)?, (\d+) sources, '
+                     r'(\d+) ms phases')
+DELIV_RE = re.compile(r'CC phase (\d+): period (\d+) ms, offered (\d+) msg/min, '
+                      r'delivered (\d+)/(\d+)')
+LAT_RE = re.compile(r'CC phase (\d+): latency p50 (\d+) ms p95 (\d+) ms')
+SRC_RE = re.compile(r'CC phase (\d+): sent (\d+) send errors \d+ relayed (\d+), '
+                    r'rpl full (\d+) duplicate relays (\d+)')
+CACHE_RE = re.compile(r'Cache dev (\d+): crpl (\d+) cache (\d+), sources (\d+) rpl full (\d+) '
+                      r'replays (\d+), relayed (\d+) duplicate (\d+), tx (\d+)')
+
+
+def parse(path):
+    run = {'sources': None, 'group': False, 'phase_ms': 0, 'phases': {}, 'nodes': []}
+    with open(path, errors='replace') as f:
+        for line in f:
+            m = SINK_RE.search(line)
+            if m:
+                run['group'] = bool(m.group(1))
+                run['sources'] = int(m.group(2))
+                run['phase_ms'] = int(m.group(3))
+                continue
+            m = DELIV_RE.search(line)
+            if m:
+                ph = run['phases'].setdefault(int(m.group(1)), {})
+                ph.update(period=int(m.group(2)), rx=int(m.group(4)), offered=int(m.group(5)))
+                continue
+            m = LAT_RE.search(line)
+            if m:
+                ph = run['phases'].setdefault(int(m.group(1)), {})
+                ph.update(p50=int(m.group(2)), p95=int(m.group(3)))
+                continue
+            m = SRC_RE.search(line)
+            if m:
+                ph = run['phases'].setdefault(int(m.group(1)), {})
+                for key, val in zip(('sent', 'relayed', 'rpl_full', 'dup'), m.groups()[1:]):
+                    ph[key] = ph.get(key, 0) + int(val)
+                continue
+            m = CACHE_RE.search(line)
+            if m:
+                run['nodes'].append(tuple(int(v) for v in m.groups()))
+    return run
+
+
+def main():
+    parser = argparse.ArgumentParser(description="RPL and message cache pressure per network size")
+    parser.add_argument('logs', nargs='+', help="Console output of one run per network size")
+    parser.add_argument('--sat', type=float, default=90,
+                        help="Delivery ratio (%%) below which a phase counts as degraded "
+                             "(default: 90)")
+    parser.add_argument('--p95-factor', type=float, default=2,
+                        help="p95 latency increase over the smallest size, at the same period, "
+                             "that counts as degraded (default: 2)")
+    args = parser.parse_args()
+
+    runs = []
+    for path in args.logs:
+        run = parse(path)
+        if run['sources'] is None:
+            print(f"Warning: no sink results in {path}, skipped", file=sys.stderr)
+            continue
+        if not run['group']:
+            print(f"Warning: {path} is not a group run, only the sink's RPL is loaded",
+                  file=sys.stderr)
+        runs.append(run)
+
+    if not runs:
+        sys.exit("Error: no convergecast results found (run test_rpl_pressure.sh)")
+
+    runs.sort(key=lambda r: r['sources'])
+    crpl = next((n[1] for r in runs for n in r['nodes']), None)
+    cache = next((n[2] for r in runs for n in r['nodes']), None)
+
+    if crpl is not None:
+        print(f"CONFIG_BT_MESH_CRPL={crpl}, CONFIG_BT_MESH_MSG_CACHE_SIZE={cache}\n")
+
+    print(" Nodes  Phase  Period [ms]  Delivered  p50 [ms]  p95 [ms]  Sent/s  Relayed/s  "
+          "RPL full  Dup relays")
+    for run in runs:
+        secs = max(run['phase_ms'], 1) / 1000
+        for idx in sorted(run['phases']):
+            ph = run['phases'][idx]
+            delivery = 100 * ph.get('rx', 0) / max(ph.get('offered', 0), 1)
+            print(f"  {run['sources'] + 1:4d}  {idx:5d}  {ph.get('period', 0):11d}  "
+                  f"{delivery:8.1f}%  {ph.get('p50', 0):8d}  {ph.get('p95', 0):8d}  "
+                  f"{ph.get('sent', 0) / secs:6.1f}  {ph.get('relayed', 0) / secs:9.1f}  "
+                  f"{ph.get('rpl_full', 0):8d}  {ph.get('dup', 0):10d}")
+
+    print("\nPer network size, all nodes:")
+    print(" Nodes  Sources/node  RPL full nodes  RPL full  Replays  Dup relays  Dup share  "
+          "TX PDUs/node")
+    for run in runs:
+        nodes = run['nodes']
+        if not nodes:
+            print(f"  {run['sources'] + 1:4d}  (no \"Cache dev\" lines)")
+            continue
+        full_nodes = sum(1 for n in nodes if n[4])
+        relayed = sum(n[6] for n in nodes)
+        dup = sum(n[7] for n in nodes)
+        print(f"  {run['sources'] + 1:4d}  {max(n[3] for n in nodes):12d}  "
+              f"{full_nodes:7d}/{len(nodes):<6d}  {sum(n[4] for n in nodes):8d}  "
+              f"{sum(n[5] for n in nodes):7d}  {dup:10d}  {100 * dup / max(relayed, 1):8.1f}%  "
+              f"{sum(n[8] for n in nodes) / len(nodes):12.0f}")
+
+    # Degradation against the smallest size, compared at the same report period
+    base = {ph['period']: ph for ph in runs[0]['phases'].values() if 'period' in ph}
+    first = {}
+    for run in runs:
+        for idx in sorted(run['phases']):
+            ph = run['phases'][idx]
+            ref = base.get(ph.get('period'))
+            where = f"{run['sources'] + 1} nodes, phase {idx} ({ph.get('period')} ms period)"
+            if 100 * ph.get('rx', 0) / max(ph.get('offered', 0), 1) < args.sat:
+                first.setdefault('delivery', where)
+            if ref and ref.get('p95') and ph.get('p95', 0) > args.p95_factor * ref['p95']:
+                first.setdefault('latency', where)
+            if ph.get('rpl_full'):
+                first.setdefault('rpl', where)
+            if ph.get('dup'):
+                first.setdefault('cache', where)
+
+    print()
+    for key, text in (('rpl', "First RPL-full rejection"),
+                      ('cache', "First duplicate relay (message cache overflow)"),
+                      ('delivery', f"Delivery first below {args.sat:g}%"),
+                      ('latency',
+                       f"p95 latency first above {args.p95_factor:g}x the smallest size")):
+        print(f"{text}: {first.get(key, 'none')}")
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,161 @@
+#!/usr/bin/env python3
+# Copyright 2025 Nordic Semiconductor
+# SPDX-License-Identifier: Apache-2.0
+
+# Assembles the hop matrix observed by the heartbeat discovery (--hb-discovery) from the console
+# output of a run, and compares it with the hop counts implied by the topology (.coeff) file.
+#
+# In the topology, two nodes are neighbours when the attenuation between them is at most
+# --max-att (the same threshold as max_att_for_conn_radius in helper_nw_att_file_creator.py),
+# and the expected hop count is the shortest path length over these links. Every row of the
+# observed matrix is one receiving node, every column one heartbeat source.
+#
+# Examples of use:
+# python3 helper_hop_matrix.py run.log network2_att_file.coeff
+# python3 helper_hop_matrix.py run.log network1_att_file.coeff --max-att 90 --strict
+
+import argparse
+import re
+import sys
+from collections import deque
+
+ROW_RE = re.compile(r'HB row (\d+):((?: (?:-|\d+|\d+/\d+))*)\s*$')
+COEFF_RE = re.compile(r'^\s*(\d+)\s+(\d+)\s*:\s*([\d.]+)')
+
+
+def parse_rows(path):
+    """Return {rx: {src: (min, max)}} from the "HB row" log lines, unheard sources left out."""
+    rows = {}
+    with open(path, errors='replace') as f:
+        for line in f:
+            m = ROW_RE.search(line)
+            if not m:
+                continue
+            row = {}
+            for src, tok in enumerate(m.group(2).split()):
+                if tok == '-':
+                    continue
+                lo, _, hi = tok.partition('/')
+                row[src] = (int(lo), int(hi or lo))
+            rows[int(m.group(1))] = row
+    return rows
+
+
+def parse_coeff(path, max_att):
+    links = {}
+    with open(path) as f:
+        for line in f:
+            m = COEFF_RE.match(line)
+            if m and float(m.group(3)) <= max_att:
+                links.setdefault(int(m.group(1)), set()).add(int(m.group(2)))
+    return links
+
+
+def expected_hops(links, src, n):
+    """Shortest path length in hops from src to every reachable node.
+
+    Only the n mesh nodes relay. Interferers are listed after them in the coeff file.
+    """
+    dist = {src: 0}
+    queue = deque([src])
+    while queue:
+        node = queue.popleft()
+        for nxt in links.get(node, ()):
+            if nxt < n and nxt not in dist:
+                dist[nxt] = dist[node] + 1
+                queue.append(nxt)
+    return dist
+
+
+def print_matrix(rows, n):
+    print("Observed min hops (row: receiver, column: source, '-': not heard):")
+    print("      " + ''.join(f"{src:>4}" for src in range(n)))
+    for rx in range(n):
+        if rx not in rows:
+            print(f"{rx:>4}  " + "   ?" * n)
+            continue
+        cells = []
+        for src in range(n):
+            if src == rx:
+                cells.append("   0")
+            elif src in rows[rx]:
+                cells.append(f"{rows[rx][src][0]:>4}")
+            else:
+                cells.append("   -")
+        print(f"{rx:>4}  " + ''.join(cells))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compare observed heartbeat hops with a topology")
+    parser.add_argument('log', help="Console output of a run with heartbeat discovery")
+    parser.add_argument('coeff', help="Topology (attenuation) file of the run")
+    parser.add_argument('--max-att', type=float, default=95,
+                        help="Highest attenuation (dB) of a usable link (default: 95)")
+    parser.add_argument('--strict', action='store_true',
+                        help="Exit with an error when the observation and topology disagree")
+    args = parser.parse_args()
+
+    rows = parse_rows(args.log)
+    if not rows:
+        sys.exit(f"Error: no heartbeat discovery rows in {args.log} (run with --hb-discovery)")
+
+    links = parse_coeff(args.coeff, args.max_att)
+    n = max([max(rows)] + [max(r) for r in rows.values() if r]) + 1
+
+    if n <= 40:
+        print_matrix(rows, n)
+
+    mismatches = []
+    asymmetric = []
+    matched = total = 0
+
+    for src in range(n):
+        expected = expected_hops(links, src, n)
+        for rx in sorted(rows):
+            if rx == src:
+                continue
+            total += 1
+            exp = expected.get(rx)
+            obs = rows[rx].get(src)
+            if obs is None and exp is None:
+                matched += 1
+            elif obs is None:
+                mismatches.append((src, rx, exp, None, "not heard, topology has a path"))
+            elif exp is None:
+                mismatches.append((src, rx, None, obs, "heard, topology has no path"))
+            elif obs[0] < exp:
+                mismatches.append((src, rx, exp, obs, "shorter than topology (extra link)"))
+            elif obs[0] > exp:
+                mismatches.append((src, rx, exp, obs, "longer than topology (lossy link)"))
+            else:
+                matched += 1
+
+            back = rows.get(src, {}).get(rx) if src in rows else None
+            if src < rx and obs is not None and back is not None and obs[0] != back[0]:
+                asymmetric.append((src, rx, obs[0], back[0]))
+
+    print(f"\n{matched} of {total} source/receiver pairs match the topology "
+          f"(links up to {args.max_att:g} dB)")
+
+    if mismatches:
+        print("\nMismatches (source -> receiver: expected hops, observed min/max):")
+        for src, rx, exp, obs, what in mismatches:
+            exp_s = '-' if exp is None else str(exp)
+            obs_s = '-' if obs is None else f"{obs[0]}/{obs[1]}"
+            print(f"  {src:>3} -> {rx:<3} expected {exp_s:>2} observed {obs_s:>5}  {what}")
+
+    if asymmetric:
+        print("\nAsymmetric routes (a <-> b: hops a->b, hops b->a):")
+        for a, b, ab, ba in asymmetric:
+            print(f"  {a:>3} <-> {b:<3} {ab} {ba}")
+
+    varying = [(rx, src, h) for rx, r in rows.items() for src, h in r.items() if h[0] != h[1]]
+    if varying:
+        print(f"\n{len(varying)} pairs saw different hop counts between heartbeats "
+              "(route changes with collisions)")
+
+    return 1 if args.strict and mismatches else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,160 @@
+#!/usr/bin/env python3
+# Copyright 2025 Nordic Semiconductor
+# SPDX-License-Identifier: Apache-2.0
+
+# Assembles the observed link matrix from the console output of a run, and compares it with the
+# attenuation of the topology (.coeff) file.
+#
+# At exit every node logs a "Links dev" line: per test node it heard, the packet count and the
+# RSSI min/mean/max (all advertisements, mesh and proxy). The expected RSSI of a link is the
+# transmit power minus its attenuation. A link is usable when the attenuation is at most
+# --max-att (the same threshold as max_att_for_conn_radius in helper_nw_att_file_creator.py).
+# The helper lists usable links that were never heard, links heard although the topology has
+# them beyond --max-att, links whose mean RSSI is more than --tol dB off, and asymmetric links.
+#
+# Examples of use:
+# python3 helper_link_matrix.py run.log network2_att_file.coeff
+# python3 helper_link_matrix.py run.log network1_att_file.coeff --tx-power 4 --tol 2 --strict
+
+import argparse
+import re
+import sys
+
+LINKS_RE = re.compile(r'Links dev (\d+):((?: \d+:\d+/-?\d+/-?\d+/-?\d+)*)\s*$')
+COEFF_RE = re.compile(r'^\s*(\d+)\s+(\d+)\s*:\s*([\d.]+)')
+
+
+def parse_links(path):
+    """Return {(tx, rx): (count, min, mean, max)} from the "Links dev" log lines."""
+    links = {}
+    rows = set()
+    with open(path, errors='replace') as f:
+        for line in f:
+            m = LINKS_RE.search(line)
+            if not m:
+                continue
+            rx = int(m.group(1))
+            rows.add(rx)
+            for tok in m.group(2).split():
+                tx, _, stats = tok.partition(':')
+                links[(int(tx), rx)] = tuple(int(v) for v in stats.split('/'))
+    return links, rows
+
+
+def parse_coeff(path):
+    att = {}
+    with open(path) as f:
+        for line in f:
+            m = COEFF_RE.match(line)
+            if m:
+                att[(int(m.group(1)), int(m.group(2)))] = float(m.group(3))
+    return att
+
+
+def print_matrix(links, rows, n):
+    print("Observed mean RSSI in dBm (row: receiver, column: transmitter, '-': not heard):")
+    print("      " + ''.join(f"{tx:>5}" for tx in range(n)))
+    for rx in range(n):
+        if rx not in rows:
+            print(f"{rx:>4}  " + "    ?" * n)
+            continue
+        cells = []
+        for tx in range(n):
+            if tx == rx:
+                cells.append("    .")
+            elif (tx, rx) in links:
+                cells.append(f"{links[(tx, rx)][2]:>5}")
+            else:
+                cells.append("    -")
+        print(f"{rx:>4}  " + ''.join(cells))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compare observed RSSI links with a topology")
+    parser.add_argument('log', help="Console output of a run")
+    parser.add_argument('coeff', help="Topology (attenuation) file of the run")
+    parser.add_argument('--max-att', type=float, default=95,
+                        help="Highest attenuation (dB) of a usable link (default: 95)")
+    parser.add_argument('--tx-power', type=float, default=0,
+                        help="Transmit power of the nodes in dBm (default: 0)")
+    parser.add_argument('--tol', type=float, default=3,
+                        help="Allowed difference of the mean RSSI from the expected one in dB "
+                             "(default: 3)")
+    parser.add_argument('--strict', action='store_true',
+                        help="Exit with an error when the observation and topology disagree")
+    args = parser.parse_args()
+
+    links, rows = parse_links(args.log)
+    if not rows:
+        sys.exit(f"Error: no \"Links dev\" lines in {args.log}")
+
+    att = parse_coeff(args.coeff)
+    n = max(list(rows) + [tx for tx, _ in links]) + 1
+
+    if n <= 30:
+        print_matrix(links, rows, n)
+        print()
+
+    missing, unexpected, off, asymmetric = [], [], [], []
+    usable = matched = 0
+
+    for rx in sorted(rows):
+        for tx in range(n):
+            if tx == rx:
+                continue
+            a = att.get((tx, rx))
+            obs = links.get((tx, rx))
+            if a is not None and a <= args.max_att:
+                usable += 1
+                if obs is None:
+                    missing.append((tx, rx, a))
+                    continue
+            elif obs is not None:
+                unexpected.append((tx, rx, a, obs))
+                continue
+            else:
+                continue
+
+            expected = args.tx_power - a
+            if abs(obs[2] - expected) > args.tol:
+                off.append((tx, rx, expected, obs))
+            else:
+                matched += 1
+
+            back = links.get((rx, tx))
+            if tx < rx and tx in rows and back is None:
+                asymmetric.append((tx, rx, obs[2], None))
+            elif tx < rx and back is not None and abs(obs[2] - back[2]) > args.tol:
+                asymmetric.append((tx, rx, obs[2], back[2]))
+
+    print(f"{matched} of {usable} usable links (up to {args.max_att:g} dB) heard within "
+          f"{args.tol:g} dB of the expected RSSI")
+
+    if missing:
+        print("\nUsable links never heard (transmitter -> receiver: attenuation):")
+        for tx, rx, a in missing:
+            print(f"  {tx:>3} -> {rx:<3} {a:6.1f} dB")
+
+    if unexpected:
+        print("\nLinks heard beyond the usable attenuation (transmitter -> receiver):")
+        for tx, rx, a, obs in unexpected:
+            a_s = "not in topology" if a is None else f"{a:6.1f} dB"
+            print(f"  {tx:>3} -> {rx:<3} {a_s}, {obs[0]} packets, RSSI {obs[1]}/{obs[2]}/{obs[3]}")
+
+    if off:
+        print("\nMean RSSI off the expected value (transmitter -> receiver):")
+        for tx, rx, expected, obs in off:
+            print(f"  {tx:>3} -> {rx:<3} expected {expected:6.1f} dBm, observed mean {obs[2]} "
+                  f"(min {obs[1]}, max {obs[3]}, {obs[0]} packets)")
+
+    if asymmetric:
+        print("\nAsymmetric links (a <-> b: mean RSSI a->b, b->a):")
+        for a, b, ab, ba in asymmetric:
+            print(f"  {a:>3} <-> {b:<3} {ab:>4} {'-' if ba is None else ba:>4}")
+
+    disagree = missing or unexpected or off or asymmetric
+    return 1 if args.strict and disagree else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -29,6 +29,21 @@ connectivity_radius = 2.9
 # fname = "network3"
 # connectivity_radius = 2.2
 
+# Topology 4
+# Creating 100 nodes in a 10x10 grid topology, for the RPL and message cache sweep
+# (test_scripts/test_rpl_pressure.sh)
+# nodes = []
+# for i in range(10):
+#     for j in range(10):
+#         nodes.append((i, j))
+# fname = "network4"
+# connectivity_radius = 2.9
+
+# Optional non-mesh background interferers (see --interferers in test_scripts/test_common.sh).
+# They get the device indices after the last node (the tester), in the order given here.
+interferers = []
+# interferers = [(2.5, 1.5), (0.5, 2.5)]
+
 # --------------------------------------------------------------------------------------------------
 
 # Attenuation beyond this will not be added in the attenuation file, and instead
@@ -68,13 +83,15 @@ def generate_attenuation_file(nodes, fname, max_att=max_att_for_conn_radius):
                 print(line2, end='')
 
 
-def visualize_network(nodes, max_distance=connectivity_radius):
+def visualize_network(nodes, interferers=None, max_distance=connectivity_radius):
+    if interferers is None:
+        interferers = []
     G = nx.Graph()
 
     # Get maximum network size in x and y directions
     x_size = 0
     y_size = 0
-    for n in nodes:
+    for n in nodes + interferers:
         x, y = n
         x_size = max(x_size, x)
         y_size = max(y_size, y)
@@ -111,8 +128,17 @@ def visualize_network(nodes, max_distance=connectivity_radius):
     nx.draw_networkx_nodes(G, pos, node_size=450)
     labels = {i: 'D'+str(i) for i in G.nodes()}
     nx.draw_networkx_labels(G, pos, labels=labels)
+
+    # Interferers are drawn without links, as they do not take part in the mesh
+    if interferers:
+        I = nx.Graph()
+        for k, node in enumerate(interferers):
+            I.add_node(len(nodes) + k, pos=node)
+        ipos = nx.get_node_attributes(I, 'pos')
+        nx.draw_networkx_nodes(I, ipos, node_size=450, node_color='orange', node_shape='s')
+        nx.draw_networkx_labels(I, ipos, labels={i: 'I'+str(i) for i in I.nodes()})
     plt.savefig(fname + ".png")
 
 
-generate_attenuation_file(nodes, fname)
-visualize_network(nodes)
\ No newline at end of file
+generate_attenuation_file(nodes + interferers, fname)
+visualize_network(nodes, interferers)
\ No newline at end of file
@@ -0,0 +1,265 @@
+#!/usr/bin/env python3
+# Copyright 2025 Nordic Semiconductor
+# SPDX-License-Identifier: Apache-2.0
+
+# Single pass analyzer for the bs_2G4_phy_v1 Tx/Rx dump files of one simulation.
+#
+# Reports per-node TX counts and airtime, overlapping transmissions (collisions) per node pair,
+# reception failures per link, channel utilization over time and advertising channel balance.
+# Dump files are streamed row by row: Tx files are merged in time order (each file is already
+# sorted) and Rx files are read one after another, so memory use does not grow with the length
+# of the simulation.
+#
+# Examples of use:
+# python3 helper_phy_dump_analyzer.py ${BSIM_OUT_PATH}/results/mesh_nw_sim_test
+# python3 helper_phy_dump_analyzer.py -s mesh_nw_sim_test --bin-ms 500 --csv out/nw1
+
+import argparse
+import csv
+import heapq
+import os
+import re
+import sys
+from collections import defaultdict
+
+# Rx status values from bs_pc_2G4_types.h
+RXSTATUS_OK = 1
+RXSTATUS_CRC_ERROR = 2
+RXSTATUS_HEADER_ERROR = 3
+
+# Advertising channels by center frequency (MHz)
+ADV_CHANNELS = {2402: 37, 2426: 38, 2480: 39}
+
+# Anything at or above this is the phy's TIME_NEVER
+TIME_NEVER = 2**63
+
+DUMP_FILE_RE = re.compile(r'(\d+)\.(Tx|Rx)\.csv$')
+
+
+def find_dumps(results_dir):
+    tx, rx = {}, {}
+    for name in os.listdir(results_dir):
+        m = DUMP_FILE_RE.search(name)
+        if not m:
+            continue
+        (tx if m.group(2) == 'Tx' else rx)[int(m.group(1))] = os.path.join(results_dir, name)
+    return tx, rx
+
+
+def column(header, *candidates, required=True):
+    for c in candidates:
+        if c in header:
+            return header.index(c)
+    if required:
+        sys.exit(f"Error: none of the columns {candidates} found in dump header {header}")
+    return None
+
+
+def to_mhz(freq):
+    """The phy dumps the center frequency either as an offset from 2400 MHz or absolute."""
+    f = float(freq)
+    return round(f + 2400 if f < 1000 else f)
+
+
+def tx_rows(dev, path):
+    """Yield (start, end, dev, freq) for every transmission in one Tx dump, in time order."""
+    with open(path, newline='') as f:
+        reader = csv.reader(f)
+        header = [h.strip() for h in next(reader, [])]
+        if not header:
+            return
+        # Prefer the packet (on-air) times when the dump has them
+        i_start = column(header, 'start_packet_time', 'start_time', 'start_tx_time')
+        i_end = column(header, 'end_packet_time', 'end_time', 'end_tx_time')
+        i_abort = column(header, 'abort_time', required=False)
+        i_freq = column(header, 'center_freq')
+
+        for row in reader:
+            start = int(row[i_start])
+            end = int(row[i_end])
+            if i_abort is not None:
+                abort = int(row[i_abort])
+                if start <= abort < min(end, TIME_NEVER):
+                    end = abort
+            yield start, end, dev, to_mhz(row[i_freq])
+
+
+class TxStats:
+    def __init__(self, bin_us):
+        self.bin_us = bin_us
+        self.count = defaultdict(int)
+        self.airtime = defaultdict(int)
+        self.collided = defaultdict(int)
+        self.pair_collisions = defaultdict(int)
+        self.adv_count = defaultdict(lambda: [0, 0, 0])
+        self.util = defaultdict(lambda: defaultdict(int))
+        self.channels = set()
+        self.end_time = 0
+
+    def add_airtime(self, freq, start, end):
+        t = start
+        while t < end:
+            b = t // self.bin_us
+            b_end = min(end, (b + 1) * self.bin_us)
+            self.util[b][freq] += b_end - t
+            t = b_end
+
+    def run(self, tx_files):
+        # Transmissions still on air per frequency: list of (end, dev, flagged)
+        active = defaultdict(list)
+        streams = [tx_rows(dev, path) for dev, path in sorted(tx_files.items())]
+
+        for start, end, dev, freq in heapq.merge(*streams):
+            self.count[dev] += 1
+            self.airtime[dev] += end - start
+            self.channels.add(freq)
+            self.end_time = max(self.end_time, end)
+            self.add_airtime(freq, start, end)
+
+            ch = ADV_CHANNELS.get(freq)
+            if ch is not None:
+                self.adv_count[dev][ch - 37] += 1
+
+            on_air = [a for a in active[freq] if a[0] > start]
+            me = [end, dev, False]
+            for other in on_air:
+                if other[1] == dev:
+                    continue
+                self.pair_collisions[tuple(sorted((dev, other[1])))] += 1
+                if not other[2]:
+                    other[2] = True
+                    self.collided[other[1]] += 1
+                if not me[2]:
+                    me[2] = True
+                    self.collided[dev] += 1
+            on_air.append(me)
+            active[freq] = on_air
+
+
+class RxStats:
+    def __init__(self):
+        self.ok = defaultdict(int)
+        self.crc_err = defaultdict(int)
+        self.hdr_err = defaultdict(int)
+        self.rssi_sum = defaultdict(float)
+
+    def run(self, rx_files):
+        for rx_dev, path in sorted(rx_files.items()):
+            with open(path, newline='') as f:
+                reader = csv.reader(f)
+                header = [h.strip() for h in next(reader, [])]
+                if not header:
+                    continue
+                i_status = column(header, 'status')
+                i_tx = column(header, 'tx_nbr')
+                i_rssi = column(header, 'RSSI', 'rssi', required=False)
+
+                for row in reader:
+                    status = int(row[i_status])
+                    if status == RXSTATUS_OK:
+                        link = (int(row[i_tx]), rx_dev)
+                        self.ok[link] += 1
+                        if i_rssi is not None:
+                            self.rssi_sum[link] += float(row[i_rssi])
+                    elif status == RXSTATUS_CRC_ERROR:
+                        self.crc_err[(int(row[i_tx]), rx_dev)] += 1
+                    elif status == RXSTATUS_HEADER_ERROR:
+                        self.hdr_err[(int(row[i_tx]), rx_dev)] += 1
+
+
+def print_tx_report(tx, top):
+    duration = max(tx.end_time, 1)
+    print("Per-node transmissions:")
+    print(f"{'Dev':<5}{'TX':>9}{'Airtime[ms]':>13}{'Duty[%]':>9}{'Collided':>10}"
+          f"{'ch37':>8}{'ch38':>8}{'ch39':>8}{'Balance':>9}")
+    for dev in sorted(tx.count):
+        adv = tx.adv_count[dev]
+        balance = min(adv) / max(adv) if max(adv) else 1.0
+        print(f"{dev:<5}{tx.count[dev]:>9}{tx.airtime[dev] / 1000:>13.1f}"
+              f"{100 * tx.airtime[dev] / duration:>9.2f}{tx.collided[dev]:>10}"
+              f"{adv[0]:>8}{adv[1]:>8}{adv[2]:>8}{balance:>9.2f}")
+
+    print(f"\nMost frequent overlapping transmission pairs (top {top}):")
+    for (a, b), n in sorted(tx.pair_collisions.items(), key=lambda x: -x[1])[:top]:
+        print(f"  {a:>3} <-> {b:<3} {n}")
+
+    print(f"\nChannel utilization per {tx.bin_us // 1000} ms bin (busiest bins, top {top}):")
+    ranked = sorted(tx.util.items(), key=lambda x: -sum(x[1].values()))[:top]
+    for b, per_ch in sorted(ranked):
+        chans = ' '.join(f"{f}:{100 * t / tx.bin_us:.1f}%" for f, t in sorted(per_ch.items()))
+        print(f"  t={b * tx.bin_us / 1e6:10.3f}s {chans}")
+
+
+def print_rx_report(rx, top):
+    links = set(rx.ok) | set(rx.crc_err) | set(rx.hdr_err)
+    rows = []
+    for link in links:
+        fails = rx.crc_err[link] + rx.hdr_err[link]
+        total = rx.ok[link] + fails
+        rows.append((fails / total if total else 0, link, total, fails))
+
+    print(f"\nReception failures per link (worst {top}, tx -> rx):")
+    print(f"  {'Link':<12}{'Synced':>9}{'CRC err':>9}{'Hdr err':>9}{'Fail[%]':>9}{'RSSI':>8}")
+    for ratio, link, total, fails in sorted(rows, key=lambda r: (-r[0], -r[3]))[:top]:
+        rssi = rx.rssi_sum[link] / rx.ok[link] if rx.ok[link] else float('nan')
+        print(f"  {link[0]:>3} -> {link[1]:<5}{total:>9}{rx.crc_err[link]:>9}"
+              f"{rx.hdr_err[link]:>9}{100 * ratio:>9.1f}{rssi:>8.1f}")
+
+
+def write_csv(prefix, tx, rx):
+    os.makedirs(os.path.dirname(prefix) or '.', exist_ok=True)
+    with open(prefix + '_nodes.csv', 'w', newline='') as f:
+        w = csv.writer(f)
+        w.writerow(['dev', 'tx', 'airtime_us', 'collided', 'ch37', 'ch38', 'ch39'])
+        for dev in sorted(tx.count):
+            w.writerow([dev, tx.count[dev], tx.airtime[dev], tx.collided[dev], *tx.adv_count[dev]])
+    with open(prefix + '_links.csv', 'w', newline='') as f:
+        w = csv.writer(f)
+        w.writerow(['tx', 'rx', 'ok', 'crc_err', 'hdr_err', 'overlaps', 'rssi_avg'])
+        for link in sorted(set(rx.ok) | set(rx.crc_err) | set(rx.hdr_err)):
+            rssi = rx.rssi_sum[link] / rx.ok[link] if rx.ok[link] else ''
+            w.writerow([*link, rx.ok[link], rx.crc_err[link], rx.hdr_err[link],
+                        tx.pair_collisions.get(tuple(sorted(link)), 0), rssi])
+    with open(prefix + '_utilization.csv', 'w', newline='') as f:
+        w = csv.writer(f)
+        chans = sorted(tx.channels)
+        w.writerow(['time_s'] + [f"{c}MHz" for c in chans])
+        for b in sorted(tx.util):
+            w.writerow([b * tx.bin_us / 1e6] + [tx.util[b].get(c, 0) / tx.bin_us for c in chans])
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Analyze bs_2G4_phy_v1 Tx/Rx dump files")
+    parser.add_argument('results_dir', nargs='?', help="Directory with the dump files")
+    parser.add_argument('-s', '--simid', help="Simulation id, looked up in $BSIM_OUT_PATH/results")
+    parser.add_argument('--bin-ms', type=int, default=1000, help="Utilization bin size (ms)")
+    parser.add_argument('--top', type=int, default=15, help="Rows to show in ranked tables")
+    parser.add_argument('--csv', metavar='PREFIX', help="Also write CSV files with this prefix")
+    args = parser.parse_args()
+
+    if args.results_dir:
+        results_dir = args.results_dir
+    elif args.simid and 'BSIM_OUT_PATH' in os.environ:
+        results_dir = os.path.join(os.environ['BSIM_OUT_PATH'], 'results', args.simid)
+    else:
+        parser.error("Give a results directory, or a simulation id with BSIM_OUT_PATH set")
+
+    tx_files, rx_files = find_dumps(results_dir)
+    if not tx_files:
+        sys.exit(f"Error: no Tx dump files in {results_dir} (was the test run with nodump?)")
+
+    tx = TxStats(args.bin_ms * 1000)
+    tx.run(tx_files)
+    rx = RxStats()
+    rx.run(rx_files)
+
+    print_tx_report(tx, args.top)
+    print_rx_report(rx, args.top)
+
+    if args.csv:
+        write_csv(args.csv, tx, rx)
+        print(f"\nCSV files written with prefix '{args.csv}'")
+
+
+if __name__ == "__main__":
+    main()
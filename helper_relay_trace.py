@@ -0,0 +1,149 @@
+#!/usr/bin/env python3
+# Copyright 2025 Nordic Semiconductor
+# SPDX-License-Identifier: Apache-2.0
+
+# Rebuilds the flood tree of every traced mesh message from the relay traces written with
+# --trace (trace_<dev>.csv, one per node), and ranks the nodes that carry the relay load.
+#
+# Each record is one copy of a network PDU a node received: source address, sequence number,
+# TTL, reception time, and the device that transmitted the copy (from its identity address,
+# -1 when unknown). For every message, the parent of a node in the flood tree is the transmitter
+# of the first copy the node received. A node relayed a message when any other node received a
+# copy of it from that node, without being its source. The forwarding delay of a relay is the
+# time from its own first reception of the message to the first time another node heard the
+# relayed copy, so it includes the relay retransmission delay and the advertising delays.
+#
+# Examples of use:
+# python3 helper_relay_trace.py /tmp/nw2_trace
+# python3 helper_relay_trace.py /tmp/nw2_trace --top 10 --msg 0x0005:120
+
+import argparse
+import csv
+import os
+import re
+import statistics
+import sys
+
+TRACE_RE = re.compile(r'trace_(\d+)\.csv$')
+
+
+def load(directory):
+    """Return {(src, seq): {dev: [(time_ms, tx, ttl, first)]}} over all trace files."""
+    msgs = {}
+    for name in sorted(os.listdir(directory)):
+        m = TRACE_RE.search(name)
+        if not m:
+            continue
+        dev = int(m.group(1))
+        with open(os.path.join(directory, name), newline='') as f:
+            for row in csv.DictReader(f):
+                key = (int(row['src']), int(row['seq']))
+                copies = msgs.setdefault(key, {}).setdefault(dev, [])
+                copies.append((int(row['time_ms']), int(row['tx']), int(row['ttl']),
+                               row['first'] == '1'))
+    return msgs
+
+
+def flood_tree(copies):
+    """Map receiver -> (parent, time_ms, ttl) from the first copy each receiver got."""
+    tree = {}
+    for dev, recs in copies.items():
+        first = min(recs)
+        tree[dev] = (first[1], first[0], first[2])
+    return tree
+
+
+def print_tree(key, copies):
+    src_dev = key[0] - 1
+    tree = flood_tree(copies)
+    children = {}
+    for dev, (parent, _, _) in tree.items():
+        children.setdefault(parent, []).append(dev)
+
+    print(f"Flood tree of 0x{key[0]:04x}:{key[1]} (dev: first reception ms, ttl, copies)")
+    seen = set()
+
+    def walk(dev, depth):
+        for child in sorted(children.get(dev, []), key=lambda d: tree[d][1]):
+            if child in seen:
+                continue
+            seen.add(child)
+            time_ms, ttl = tree[child][1], tree[child][2]
+            print(f"  {'  ' * depth}{child}: {time_ms} ms, ttl {ttl}, {len(copies[child])} copies")
+            walk(child, depth + 1)
+
+    print(f"  {src_dev} (source)")
+    walk(src_dev, 1)
+
+    orphans = sorted(set(tree) - seen - {src_dev})
+    if orphans:
+        print(f"  Transmitter unknown or not traced: {orphans}")
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Relay load and flood trees from relay traces")
+    parser.add_argument('dir', help="Directory with the trace_<dev>.csv files of a run")
+    parser.add_argument('--top', type=int, default=20, help="Relays to list (default: 20)")
+    parser.add_argument('--msg', action='append', default=[],
+                        help="Print the flood tree of message SRC:SEQ (e.g. 0x0005:120)")
+    args = parser.parse_args()
+
+    msgs = load(args.dir)
+    if not msgs:
+        sys.exit(f"Error: no trace_<dev>.csv files with records in {args.dir}")
+
+    forwarded = {}   # dev -> messages it relayed
+    parent_of = {}   # dev -> receivers that got their first copy from it
+    delays = {}      # dev -> forwarding delays in ms
+    unknown_tx = copies_total = 0
+
+    for (src, _), copies in msgs.items():
+        src_dev = src - 1
+        first_rx = {dev: min(recs)[0] for dev, recs in copies.items()}
+        heard_from = {}
+        for dev, recs in copies.items():
+            for time_ms, tx, _, _ in recs:
+                copies_total += 1
+                if tx < 0:
+                    unknown_tx += 1
+                elif tx != src_dev and tx != dev:
+                    heard_from[tx] = min(heard_from.get(tx, time_ms), time_ms)
+
+        for relay, time_ms in heard_from.items():
+            forwarded[relay] = forwarded.get(relay, 0) + 1
+            if relay in first_rx:
+                delays.setdefault(relay, []).append(time_ms - first_rx[relay])
+
+        for dev, (parent, _, _) in flood_tree(copies).items():
+            if parent >= 0 and parent != src_dev:
+                parent_of[parent] = parent_of.get(parent, 0) + 1
+
+    nodes = len([n for n in os.listdir(args.dir) if TRACE_RE.search(n)])
+    print(f"{len(msgs)} messages, {copies_total} received copies traced by {nodes} nodes")
+    if unknown_tx:
+        print(f"{unknown_tx} copies with an unknown transmitter (not using identity addresses)")
+
+    ranked = sorted(forwarded, key=lambda d: (-forwarded[d], d))
+    print(f"\nTop relays ({len(ranked)} nodes relayed at least one message):")
+    print("   Dev  Relayed   Share  Tree parent   Delay p50   Delay max")
+    for dev in ranked[:args.top]:
+        d = delays.get(dev, [])
+        p50 = f"{statistics.median(d):8.0f} ms" if d else "       - ms"
+        dmax = f"{max(d):8d} ms" if d else "       - ms"
+        print(f"  {dev:4d}  {forwarded[dev]:7d}  {100 * forwarded[dev] / len(msgs):5.1f}%  "
+              f"{parent_of.get(dev, 0):11d}  {p50}  {dmax}")
+
+    for spec in args.msg:
+        src, _, seq = spec.partition(':')
+        key = (int(src, 0), int(seq, 0))
+        print()
+        if key not in msgs:
+            print(f"Message {spec} was not traced")
+            continue
+        print_tree(key, msgs[key])
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,334 @@
+#!/usr/bin/env python3
+# Copyright 2025 Nordic Semiconductor
+# SPDX-License-Identifier: Apache-2.0
+
+# Local SQLite store of test results, for queries across many runs.
+#
+# "ingest" parses the console output of one run (the tester log lines) and appends the run
+# metadata, the per-device results and every per-iteration latency sample to the database.
+# RunTest in _mesh_test.sh does this automatically when RESULTS_DB is set. "latency" answers
+# the common questions from the indexed tables, "runs" lists what is stored and "sql" runs any
+# other query.
+#
+# Examples of use:
+# python3 helper_results_db.py ingest run.log --db results.db --coeff network2_att_file.coeff \
+#     --conf prj.conf --label sdk-2.9
+# python3 helper_results_db.py latency --db results.db --topology network2 --hops 6
+# python3 helper_results_db.py latency --db results.db --topology network2 --group-by label
+# python3 helper_results_db.py sql --db results.db "SELECT label, COUNT(*) FROM runs GROUP BY 1"
+
+import argparse
+import datetime
+import hashlib
+import json
+import os
+import re
+import shlex
+import sqlite3
+import subprocess
+import sys
+
+SCHEMA = """
+CREATE TABLE IF NOT EXISTS runs (
+    id INTEGER PRIMARY KEY,
+    ingested TEXT NOT NULL,
+    simid TEXT,
+    label TEXT,
+    topology TEXT,
+    topology_sha TEXT,
+    node_count INTEGER,
+    conf_sha TEXT,
+    app_rev TEXT,
+    zephyr_rev TEXT,
+    testids TEXT,
+    params TEXT,
+    status INTEGER,
+    log_path TEXT
+);
+CREATE TABLE IF NOT EXISTS run_params (
+    run_id INTEGER NOT NULL REFERENCES runs(id),
+    key TEXT NOT NULL,
+    value TEXT,
+    PRIMARY KEY (run_id, key)
+);
+CREATE TABLE IF NOT EXISTS devices (
+    run_id INTEGER NOT NULL REFERENCES runs(id),
+    dev INTEGER NOT NULL,
+    addr INTEGER,
+    hops INTEGER,
+    avg_ms INTEGER,
+    failures INTEGER,
+    PRIMARY KEY (run_id, dev)
+);
+CREATE TABLE IF NOT EXISTS samples (
+    run_id INTEGER NOT NULL REFERENCES runs(id),
+    dev INTEGER NOT NULL,
+    bearer TEXT NOT NULL,
+    iter INTEGER NOT NULL,
+    latency_ms INTEGER,
+    ok INTEGER NOT NULL
+);
+CREATE INDEX IF NOT EXISTS runs_topology ON runs(topology, label);
+CREATE INDEX IF NOT EXISTS run_params_kv ON run_params(key, value);
+CREATE INDEX IF NOT EXISTS devices_hops ON devices(hops, run_id, dev);
+CREATE INDEX IF NOT EXISTS samples_run_dev ON samples(run_id, dev, bearer);
+"""
+
+# Tester log lines, matched on the message part after "<inf> module: "
+LINE_RE = re.compile(r'<(?:inf|err|wrn|dbg)> \w+: (.*)$')
+TOTAL_RE = re.compile(r'Total Devices : (\d+)')
+DUT_RE = re.compile(r'Testing latency for Dev: 0x[0-9a-f]+ \(ID: (\d+)\)')
+LATENCY_RE = re.compile(r'^Latency: (-?\d+)')
+FAILED_RE = re.compile(r'(?:Health Attention Get|Vendor Set) failed')
+BEARER_RE = re.compile(r'Measuring over (ADV|GATT proxy) bearer')
+RESULT_RE = re.compile(r'Dev (\d+) addr (0x[0-9a-f]+) avg latency:\s*(-?\d+) ms failures (\d+)')
+HOPS_RE = re.compile(r'Dev (\d+) hops (\d+)')
+
+
+def sha256_of(paths):
+    h = hashlib.sha256()
+    for path in paths:
+        with open(path, 'rb') as f:
+            h.update(f.read())
+    return h.hexdigest()[:16]
+
+
+def git_rev(path):
+    """Revision of the git tree at path, with a "-dirty" suffix for uncommitted changes."""
+    if not path or not os.path.isdir(path):
+        return None
+    try:
+        rev = subprocess.run(['git', '-C', path, 'rev-parse', '--short=12', 'HEAD'],
+                             capture_output=True, text=True, check=True).stdout.strip()
+        dirty = subprocess.run(['git', '-C', path, 'status', '--porcelain', '-uno'],
+                               capture_output=True, text=True, check=True).stdout.strip()
+    except (OSError, subprocess.CalledProcessError):
+        return None
+    return rev + ('-dirty' if dirty else '')
+
+
+def parse_params(args_str):
+    """Turn the "-argstest key=value ..." device options into a dict."""
+    params = {}
+    for tok in shlex.split(args_str or ''):
+        if '=' in tok and not tok.startswith('-'):
+            key, value = tok.split('=', 1)
+            params[key] = value
+    return params
+
+
+def parse_log(lines):
+    """Collect per-device results and per-iteration samples from the tester output."""
+    node_count = None
+    devices = {}
+    samples = []
+    bearer = 'ADV'
+    dut = None
+    iteration = 0
+
+    for line in lines:
+        m = LINE_RE.search(line)
+        if not m:
+            continue
+        msg = m.group(1)
+
+        if (m := TOTAL_RE.search(msg)):
+            node_count = int(m.group(1))
+        elif (m := BEARER_RE.search(msg)):
+            bearer = 'GATT' if m.group(1) == 'GATT proxy' else 'ADV'
+        elif (m := DUT_RE.search(msg)):
+            dut = int(m.group(1))
+            iteration = 0
+        elif dut is not None and (m := LATENCY_RE.search(msg)):
+            samples.append((dut, bearer, iteration, int(m.group(1)), 1))
+            iteration += 1
+        elif dut is not None and FAILED_RE.search(msg):
+            samples.append((dut, bearer, iteration, None, 0))
+            iteration += 1
+        elif (m := RESULT_RE.search(msg)):
+            dev = devices.setdefault(int(m.group(1)), {})
+            dev.update(addr=int(m.group(2), 16), avg_ms=int(m.group(3)),
+                       failures=int(m.group(4)))
+        elif (m := HOPS_RE.search(msg)):
+            devices.setdefault(int(m.group(1)), {})['hops'] = int(m.group(2))
+
+    # Devices that were probed but never reached the summary (e.g. the run was cut short)
+    for dev, *_ in samples:
+        devices.setdefault(dev, {})
+
+    return node_count, devices, samples
+
+
+def connect(path):
+    db = sqlite3.connect(path)
+    db.executescript(SCHEMA)
+    return db
+
+
+def cmd_ingest(args):
+    with open(args.log, errors='replace') as f:
+        node_count, devices, samples = parse_log(f)
+
+    if not devices:
+        sys.exit(f"Error: no tester results found in {args.log}")
+
+    topology = topology_sha = None
+    if args.coeff:
+        topology = os.path.splitext(os.path.basename(args.coeff))[0]
+        topology_sha = sha256_of([args.coeff])
+
+    conf = [c for c in args.conf if os.path.isfile(c)]
+    params = parse_params(args.params)
+
+    db = connect(args.db)
+    with db:
+        cur = db.execute(
+            "INSERT INTO runs (ingested, simid, label, topology, topology_sha, node_count, "
+            "conf_sha, app_rev, zephyr_rev, testids, params, status, log_path) "
+            "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)",
+            (datetime.datetime.now().isoformat(timespec='seconds'), args.simid, args.label,
+             topology, topology_sha, node_count or args.nodes,
+             sha256_of(conf) if conf else None, git_rev(args.app_dir),
+             git_rev(os.environ.get('ZEPHYR_BASE')), args.testids, json.dumps(params),
+             args.status, os.path.abspath(args.log)))
+        run_id = cur.lastrowid
+        db.executemany("INSERT INTO run_params VALUES (?, ?, ?)",
+                       [(run_id, k, v) for k, v in params.items()])
+        db.executemany("INSERT INTO devices VALUES (?, ?, ?, ?, ?, ?)",
+                       [(run_id, dev, d.get('addr'), d.get('hops'), d.get('avg_ms'),
+                         d.get('failures')) for dev, d in sorted(devices.items())])
+        db.executemany("INSERT INTO samples VALUES (?, ?, ?, ?, ?, ?)",
+                       [(run_id, *s) for s in samples])
+
+    print(f"Stored run {run_id} ({topology or 'no topology'}, {len(devices)} devices, "
+          f"{len(samples)} samples) in {args.db}")
+
+
+def percentile(sorted_values, pct):
+    """Nearest-rank percentile, same definition as bt_mesh_tst_percentile()."""
+    if not sorted_values:
+        return None
+    rank = max(1, -(-pct * len(sorted_values) // 100))
+    return sorted_values[rank - 1]
+
+
+def cmd_latency(args):
+    where = ["s.ok = 1"]
+    binds = []
+    if args.topology:
+        where.append("r.topology LIKE ?")
+        binds.append(args.topology + '%')
+    if args.label:
+        where.append("r.label = ?")
+        binds.append(args.label)
+    if args.hops is not None:
+        where.append("d.hops = ?")
+        binds.append(args.hops)
+    if args.dev is not None:
+        where.append("s.dev = ?")
+        binds.append(args.dev)
+    if args.bearer:
+        where.append("s.bearer = ?")
+        binds.append(args.bearer)
+    for kv in args.param:
+        key, _, value = kv.partition('=')
+        where.append("r.id IN (SELECT run_id FROM run_params WHERE key = ? AND value = ?)")
+        binds += [key, value]
+
+    group = {'none': "''", 'hops': 'd.hops', 'dev': 's.dev', 'run': 'r.id',
+             'label': 'r.label', 'topology': 'r.topology', 'bearer': 's.bearer'}[args.group_by]
+
+    db = connect(args.db)
+    rows = db.execute(
+        f"SELECT {group}, s.latency_ms, r.id FROM samples s "
+        "JOIN devices d ON d.run_id = s.run_id AND d.dev = s.dev "
+        "JOIN runs r ON r.id = s.run_id "
+        f"WHERE {' AND '.join(where)} ORDER BY 1, 2", binds).fetchall()
+
+    groups = {}
+    for key, latency, run_id in rows:
+        g = groups.setdefault(key, ([], set()))
+        g[0].append(latency)
+        g[1].add(run_id)
+
+    if not groups:
+        print("No matching samples")
+        return
+
+    print(f"{args.group_by:<16}{'Runs':>6}{'Samples':>9}{'Mean':>8}{'p50':>7}{'p95':>7}"
+          f"{'p' + str(args.pct):>7}{'Max':>7}")
+    for key, (values, runs) in groups.items():
+        print(f"{str(key):<16}{len(runs):>6}{len(values):>9}{sum(values) / len(values):>8.1f}"
+              f"{percentile(values, 50):>7}{percentile(values, 95):>7}"
+              f"{percentile(values, args.pct):>7}{values[-1]:>7}")
+
+
+def cmd_runs(args):
+    db = connect(args.db)
+    print(f"{'Id':>5}  {'Ingested':<20}{'Label':<14}{'Topology':<22}{'Nodes':>6}  "
+          f"{'App rev':<20}{'Zephyr rev':<14}{'Status':>6}")
+    for row in db.execute("SELECT id, ingested, label, topology, node_count, app_rev, "
+                          "zephyr_rev, status FROM runs ORDER BY id"):
+        print(f"{row[0]:>5}  {row[1]:<20}{row[2] or '':<14}{row[3] or '':<22}"
+              f"{row[4] or '':>6}  {row[5] or '':<20}{row[6] or '':<14}{row[7]:>6}")
+
+
+def cmd_sql(args):
+    db = connect(args.db)
+    cur = db.execute(args.query)
+    if cur.description:
+        print('\t'.join(c[0] for c in cur.description))
+    for row in cur:
+        print('\t'.join('' if v is None else str(v) for v in row))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Store and query mesh simulation results")
+    parser.add_argument('--db', default=os.environ.get('RESULTS_DB', 'results.db'),
+                        help="SQLite database file (default: $RESULTS_DB or results.db)")
+    sub = parser.add_subparsers(dest='cmd', required=True)
+
+    p = sub.add_parser('ingest', help="Append the results of one run")
+    p.add_argument('log', help="Console output of the run")
+    p.add_argument('--db', default=argparse.SUPPRESS)
+    p.add_argument('--coeff', help="Topology (attenuation) file used by the run")
+    p.add_argument('--conf', action='append', default=[],
+                   help="prj.conf and overlay files the devices were built with")
+    p.add_argument('--app-dir', help="Application git tree, for the revision")
+    p.add_argument('--simid')
+    p.add_argument('--label', help="Free-form tag, e.g. the SDK version under test")
+    p.add_argument('--testids', help="Roles of the devices, in device order")
+    p.add_argument('--params', help="Options passed to the devices after -argstest")
+    p.add_argument('--nodes', type=int, help="Node count, if the log does not report it")
+    p.add_argument('--status', type=int, default=0, help="Exit status of the simulation")
+    p.set_defaults(func=cmd_ingest)
+
+    p = sub.add_parser('latency', help="Latency statistics over the matching samples")
+    p.add_argument('--db', default=argparse.SUPPRESS)
+    p.add_argument('--topology', help="Topology name prefix, e.g. network2")
+    p.add_argument('--label')
+    p.add_argument('--hops', type=int)
+    p.add_argument('--dev', type=int)
+    p.add_argument('--bearer', choices=['ADV', 'GATT'])
+    p.add_argument('--param', action='append', default=[], metavar='KEY=VALUE',
+                   help="Only runs with this device option, e.g. iterations=20")
+    p.add_argument('--pct', type=int, default=99, help="Extra percentile to report")
+    p.add_argument('--group-by', default='none',
+                   choices=['none', 'hops', 'dev', 'run', 'label', 'topology', 'bearer'])
+    p.set_defaults(func=cmd_latency)
+
+    p = sub.add_parser('runs', help="List the stored runs")
+    p.add_argument('--db', default=argparse.SUPPRESS)
+    p.set_defaults(func=cmd_runs)
+
+    p = sub.add_parser('sql', help="Run an SQL query")
+    p.add_argument('--db', default=argparse.SUPPRESS)
+    p.add_argument('query')
+    p.set_defaults(func=cmd_sql)
+
+    args = parser.parse_args()
+    args.func(args)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,225 @@
+#!/usr/bin/env python3
+# Copyright 2025 Nordic Semiconductor
+# SPDX-License-Identifier: Apache-2.0
+
+# Launches the phy and all device processes of one simulation, pins them to CPUs, supervises
+# their exit codes and the global timeout, and reports per-process CPU time at the end.
+#
+# Used by RunTest in _mesh_test.sh. Example of direct use:
+# ./helper_sim_launcher.py --timeout 8000 --phy "./bs_2G4_phy_v1 -s=sim -D=2" \
+#     --dev "./bs_nrf52_bsim_app -s=sim -d=0 -testid=node_device" \
+#     --dev "./bs_nrf52_bsim_app -s=sim -d=1 -testid=node_tester"
+
+import argparse
+import os
+import shlex
+import signal
+import subprocess
+import sys
+import time
+
+# Same grace period as the "timeout --kill-after" used by sh_common.source
+KILL_AFTER_SEC = 5
+
+
+def parse_cpu_list(cpu_str):
+    """Parse a Linux cpulist string like "0-3,8,10-11" into a sorted list of CPU numbers."""
+    cpus = set()
+    for part in cpu_str.strip().split(','):
+        if not part:
+            continue
+        if '-' in part:
+            lo, hi = part.split('-')
+            cpus.update(range(int(lo), int(hi) + 1))
+        else:
+            cpus.add(int(part))
+    return sorted(cpus)
+
+
+def numa_nodes(allowed):
+    """Return the allowed CPUs grouped per NUMA node, or a single group if NUMA is unknown."""
+    base = '/sys/devices/system/node'
+    groups = []
+    try:
+        for entry in sorted(os.listdir(base)):
+            if not entry.startswith('node') or not entry[4:].isdigit():
+                continue
+            with open(os.path.join(base, entry, 'cpulist')) as f:
+                cpus = [c for c in parse_cpu_list(f.read()) if c in allowed]
+            if cpus:
+                groups.append(cpus)
+    except OSError:
+        pass
+    return groups if groups else [sorted(allowed)]
+
+
+def plan_affinity(n_devs, allowed, phy_cpu, spread):
+    """Return (phy_cpus, [dev_cpus...]) affinity sets.
+
+    The phy gets a core of its own since every device synchronizes with it. Devices are
+    spread over the remaining cores one core each ("cpu"), over the NUMA nodes with the whole
+    node as affinity ("numa"), or left unpinned ("none").
+    """
+    allowed = sorted(allowed)
+    if spread == 'none':
+        return None, [None] * n_devs
+
+    if phy_cpu is None:
+        phy_cpu = allowed[0]
+    if phy_cpu not in allowed:
+        sys.exit(f"Error: phy CPU {phy_cpu} is not in the allowed CPU set {allowed}")
+
+    rest = [c for c in allowed if c != phy_cpu] or [phy_cpu]
+
+    if spread == 'numa':
+        groups = [[c for c in g if c != phy_cpu] for g in numa_nodes(rest + [phy_cpu])]
+        groups = [g for g in groups if g] or [rest]
+        return [phy_cpu], [groups[i % len(groups)] for i in range(n_devs)]
+
+    return [phy_cpu], [[rest[i % len(rest)]] for i in range(n_devs)]
+
+
+class Proc:
+    def __init__(self, name, cmd, cpus):
+        self.name = name
+        self.cmd = cmd
+        self.cpus = cpus
+        self.popen = None
+        self.status = None
+        self.cpu_time = 0.0
+        self.wall = 0.0
+        self.t_start = 0.0
+
+    def missing(self):
+        """Return the error message if the executable does not exist, or None."""
+        exe = self.cmd[0]
+        if not os.path.isfile(exe):
+            return (f"Error: {os.getcwd()}/{os.path.basename(exe)} cannot be found "
+                    "(did you forget to compile it?)")
+        return None
+
+    def start(self):
+        cpus = self.cpus
+
+        def pin():
+            if cpus:
+                os.sched_setaffinity(0, cpus)
+
+        self.t_start = time.monotonic()
+        self.popen = subprocess.Popen(self.cmd, preexec_fn=pin)
+
+
+def reap(procs_by_pid, block):
+    """Collect one exited child with its resource usage. Returns False if none was ready."""
+    try:
+        pid, status, rusage = os.wait4(-1, 0 if block else os.WNOHANG)
+    except ChildProcessError:
+        return False
+    if pid == 0:
+        return False
+
+    p = procs_by_pid.get(pid)
+    if p is None:
+        return True
+
+    p.status = os.waitstatus_to_exitcode(status)
+    p.cpu_time = rusage.ru_utime + rusage.ru_stime
+    p.wall = time.monotonic() - p.t_start
+    p.popen.returncode = p.status
+    return True
+
+
+def signal_all(procs, sig):
+    for p in procs:
+        if p.popen is not None and p.status is None:
+            try:
+                p.popen.send_signal(sig)
+            except ProcessLookupError:
+                pass
+
+
+def print_report(procs, timed_out):
+    print("Simulation process report:")
+    print(f"{'Process':<10}{'PID':>9}{'Exit':>7}{'CPU [s]':>11}{'Wall [s]':>11}  CPUs")
+    for p in procs:
+        cpus = ','.join(str(c) for c in p.cpus) if p.cpus else 'any'
+        status = 'kill' if p.status is None else str(p.status)
+        print(f"{p.name:<10}{p.popen.pid:>9}{status:>7}{p.cpu_time:>11.2f}{p.wall:>11.2f}  {cpus}")
+
+    total = sum(p.cpu_time for p in procs)
+    busiest = max(procs, key=lambda p: p.cpu_time)
+    print(f"Total CPU time {total:.2f} s, "
+          f"busiest process {busiest.name} ({busiest.cpu_time:.2f} s)")
+    if timed_out:
+        print("Simulation timed out")
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Launch and supervise a BabbleSim simulation")
+    parser.add_argument('--phy', required=True, help="Phy command line")
+    parser.add_argument('--dev', action='append', default=[], help="Device command line")
+    parser.add_argument('--timeout', type=float, default=0,
+                        help="Wall-clock timeout in seconds for the whole simulation (0: none)")
+    parser.add_argument('--phy-cpu', type=int, default=None,
+                        help="CPU dedicated to the phy (default: first allowed CPU)")
+    parser.add_argument('--cpus', default=None,
+                        help="CPUs to use, as a cpulist like \"0-7,16\" (default: inherited)")
+    parser.add_argument('--spread', choices=['cpu', 'numa', 'none'], default='cpu',
+                        help="How to place device processes on the remaining CPUs")
+    args = parser.parse_args()
+
+    allowed = parse_cpu_list(args.cpus) if args.cpus else sorted(os.sched_getaffinity(0))
+    phy_cpus, dev_cpus = plan_affinity(len(args.dev), allowed, args.phy_cpu, args.spread)
+
+    procs = [Proc(f"d_{i:02d}", shlex.split(cmd), dev_cpus[i]) for i, cmd in enumerate(args.dev)]
+    procs.append(Proc("phy", shlex.split(args.phy), phy_cpus))
+
+    # Check every executable before starting any process, so none is left running on its own
+    for p in procs:
+        error = p.missing()
+        if error:
+            sys.exit(error)
+
+    # Forward Ctrl+C / termination to the whole simulation
+    def on_signal(sig, frame):
+        signal_all(procs, signal.SIGTERM)
+    signal.signal(signal.SIGINT, on_signal)
+    signal.signal(signal.SIGTERM, on_signal)
+
+    for p in procs:
+        p.start()
+
+    procs_by_pid = {p.popen.pid: p for p in procs}
+    deadline = time.monotonic() + args.timeout if args.timeout > 0 else None
+    kill_at = None
+    timed_out = False
+
+    while any(p.status is None for p in procs):
+        now = time.monotonic()
+
+        if deadline and now >= deadline and not timed_out:
+            timed_out = True
+            print(f"Simulation timeout ({args.timeout:.0f} s) reached, terminating", flush=True)
+            signal_all(procs, signal.SIGTERM)
+            kill_at = now + KILL_AFTER_SEC
+
+        if kill_at and now >= kill_at:
+            signal_all(procs, signal.SIGKILL)
+            kill_at = None
+
+        if deadline is None and kill_at is None:
+            reap(procs_by_pid, block=True)
+        elif not reap(procs_by_pid, block=False):
+            time.sleep(0.05)
+
+    print_report(procs, timed_out)
+
+    failed = [p for p in procs if p.status != 0]
+    for p in failed:
+        print(f"\033[91m{p.name} (pid {p.popen.pid}) failed with exit code {p.status}\033[39m")
+
+    return 1 if failed or timed_out else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,169 @@
+#!/usr/bin/env python3
+# Copyright 2025 Nordic Semiconductor
+# SPDX-License-Identifier: Apache-2.0
+
+# Summarizes the simulation speed profile of a run made with --profile, from its console output.
+#
+# Every device logs its per-phase simulated, wall-clock and CPU time, and cumulative samples of
+# them (the "Prof" lines). The devices and the phy advance in lockstep, so the wall-clock time of
+# an interval is set by the process that needs the most CPU time for it; the others wait for it.
+# The summary gives per phase the simulation speed and the processes using the most CPU, and
+# per time bin the busiest process. The CPU time of the phy is taken from the process report of
+# helper_sim_launcher.py when the log contains it.
+#
+# Examples of use:
+# python3 helper_sim_profile.py nw2.log
+# python3 helper_sim_profile.py nw2.log --bin-ms 20000 --top 5
+
+import argparse
+import bisect
+import re
+import sys
+
+PHASE_RE = re.compile(r'Prof dev (\d+) phase (\S+): sim (\d+) ms wall (\d+) ms cpu (\d+) ms')
+SAMPLE_RE = re.compile(r'Prof dev (\d+) sample sim (\d+) wall (\d+) cpu (\d+)')
+START_RE = re.compile(r'Prof dev (\d+): \d+ samples .*first phase at sim (\d+) ms')
+PROC_RE = re.compile(r'^(phy|d_\d+)\s+\d+\s+\S+\s+([\d.]+)\s+([\d.]+)')
+
+
+def parse(path):
+    phases = {}    # dev -> [(name, sim_ms, wall_ms, cpu_ms)]
+    samples = {}   # dev -> [(sim_ms, wall_ms, cpu_ms)]
+    procs = {}     # process name -> (cpu_s, wall_s)
+    with open(path, errors='replace') as f:
+        for line in f:
+            # Samples are cumulative since the first phase started, so its start is a sample
+            # of its own, which the device may have dropped when compacting its buffer
+            m = START_RE.search(line)
+            if m:
+                samples.setdefault(int(m.group(1)), []).append((int(m.group(2)), 0, 0))
+                continue
+            m = PHASE_RE.search(line)
+            if m:
+                phases.setdefault(int(m.group(1)), []).append(
+                    (m.group(2), int(m.group(3)), int(m.group(4)), int(m.group(5))))
+                continue
+            m = SAMPLE_RE.search(line)
+            if m:
+                samples.setdefault(int(m.group(1)), []).append(
+                    tuple(int(m.group(i)) for i in (2, 3, 4)))
+                continue
+            m = PROC_RE.match(line)
+            if m:
+                procs[m.group(1)] = (float(m.group(2)), float(m.group(3)))
+    return phases, samples, procs
+
+
+def interp(points, sim_ms, idx):
+    """Value idx (1: wall, 2: cpu) of the cumulative samples at sim_ms, None if outside."""
+    sims = [p[0] for p in points]
+    i = bisect.bisect_left(sims, sim_ms)
+    if i < len(points) and sims[i] == sim_ms:
+        return points[i][idx]
+    if i == 0 or i == len(points):
+        return None
+    a, b = points[i - 1], points[i]
+    return a[idx] + (b[idx] - a[idx]) * (sim_ms - a[0]) / (b[0] - a[0])
+
+
+def phase_at(dev_phases, start_ms, sim_ms):
+    """Name of the phase a device was in at sim_ms, its first phase starting at start_ms."""
+    t = start_ms
+    for name, dur, _, _ in dev_phases:
+        if name == 'total':
+            continue
+        t += dur
+        if sim_ms < t:
+            return name
+    return dev_phases[-2][0] if len(dev_phases) > 1 else '?'
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Find the processes and phases limiting a run")
+    parser.add_argument('log', help="Console output of a run made with --profile")
+    parser.add_argument('--bin-ms', type=int, default=0,
+                        help="Simulated time bin of the timeline (default: largest sample period)")
+    parser.add_argument('--top', type=int, default=3, help="Processes listed per phase")
+    args = parser.parse_args()
+
+    phases, samples, procs = parse(args.log)
+    if not phases:
+        sys.exit(f"Error: no profiling lines in {args.log} (run with --profile)")
+
+    totals = {dev: next((p for p in ph if p[0] == 'total'), None) for dev, ph in phases.items()}
+
+    print("Per phase (wall time and speed of the slowest device, top CPU users):")
+    names = []
+    for ph in phases.values():
+        for name, _, _, _ in ph:
+            if name != 'total' and name not in names:
+                names.append(name)
+
+    for name in names + ['total']:
+        rows = [(dev, sim, wall, cpu) for dev, ph in phases.items()
+                for n, sim, wall, cpu in ph if n == name]
+        wall = max(r[2] for r in rows)
+        sim = max(r[1] for r in rows)
+        top = sorted(rows, key=lambda r: -r[3])[:args.top]
+        users = ', '.join(f"d_{dev:02d} {cpu / 1000:.1f} s ({100 * cpu // max(w, 1)}%)"
+                          for dev, _, w, cpu in top)
+        print(f"  {name:<14} {len(rows):3d} devs  sim {sim / 1000:8.1f} s  "
+              f"wall {wall / 1000:8.1f} s  speed {sim / max(wall, 1):6.3f}  {users}")
+
+    ranked = sorted((t[3], dev) for dev, t in totals.items() if t)[::-1]
+    print("\nSlowest processes (CPU time over the whole run):")
+    if 'phy' in procs:
+        cpu, wall = procs['phy']
+        print(f"  phy   {cpu:8.1f} s  ({100 * cpu / max(wall, 1e-3):.0f}% of its wall time)")
+    for cpu, dev in ranked[:max(args.top, 5)]:
+        wall = totals[dev][2]
+        print(f"  d_{dev:02d}  {cpu / 1000:8.1f} s  "
+              f"({100 * cpu // max(wall, 1)}% of its wall time)")
+
+    samples = {dev: sorted(set(s)) for dev, s in samples.items() if len(set(s)) > 1}
+    if not samples:
+        return 0
+
+    bin_ms = args.bin_ms or max(s[-1][0] - s[-2][0] for s in samples.values())
+    start = min(s[0][0] for s in samples.values())
+    end = max(s[-1][0] for s in samples.values())
+    busiest = {}
+    slow_bins = []
+
+    for t0 in range(start, end - bin_ms + 1, bin_ms):
+        t1 = t0 + bin_ms
+        use = []
+        walls = []
+        for dev, s in samples.items():
+            c0, c1 = interp(s, t0, 2), interp(s, t1, 2)
+            w0, w1 = interp(s, t0, 1), interp(s, t1, 1)
+            if None in (c0, c1, w0, w1):
+                continue
+            use.append((c1 - c0, dev))
+            walls.append(w1 - w0)
+        if not use:
+            continue
+        cpu, dev = max(use)
+        wall = max(walls)
+        busiest[dev] = busiest.get(dev, 0) + 1
+        slow_bins.append((bin_ms / max(wall, 1), t0, dev, cpu, wall))
+
+    if not slow_bins:
+        return 0
+
+    print(f"\nBusiest process per {bin_ms / 1000:g} s of simulated time "
+          f"(bins where it used the most CPU):")
+    for dev, n in sorted(busiest.items(), key=lambda x: -x[1])[:max(args.top, 5)]:
+        print(f"  d_{dev:02d}  {n:4d} of {len(slow_bins)} bins")
+
+    print("\nSlowest time bins:")
+    for speed, t0, dev, cpu, wall in sorted(slow_bins)[:5]:
+        name = phase_at(phases[dev], samples[dev][0][0], t0) if dev in phases else '?'
+        print(f"  sim {t0 / 1000:8.1f} s  speed {speed:6.3f}  busiest d_{dev:02d} "
+              f"({100 * cpu / max(wall, 1):.0f}% CPU, {name})")
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
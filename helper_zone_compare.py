@@ -0,0 +1,108 @@
+#!/usr/bin/env python3
+# Copyright 2025 Nordic Semiconductor
+# SPDX-License-Identifier: Apache-2.0
+
+# Compares a subnet partitioned run with its single-subnet baseline (test_zones.sh), from the
+# console output of both runs.
+#
+# The tester logs the latency of the DUTs in its own zone (intra-zone), in the other zones
+# (cross-zone) and per zone. Every node logs its zone, whether it joins every zone (border), and
+# how many PDUs it relayed and sent in total. The helper lists the latency of both runs side
+# by side, and the relay load per zone and of the border nodes. The total PDUs sent by all nodes
+# stand for the channel load.
+#
+# Examples of use:
+# python3 helper_zone_compare.py results/zones_20250101_120000/baseline.log \
+#     results/zones_20250101_120000/zoned.log
+# python3 helper_zone_compare.py baseline.log zoned.log --top 10
+
+import argparse
+import re
+import sys
+
+LAT_RE = re.compile(r'Zone latency (.+?): (\d+) DUTs, (\d+)/(\d+) answered, '
+                    r'mean (-?\d+) ms p50 (\d+) ms p95 (\d+) ms')
+NODE_RE = re.compile(r'Zone dev (\d+): zone (\d+) net (\d+)( border)?, relayed (\d+) tx (\d+)')
+
+
+def parse(path):
+    lat = {}     # class -> (duts, answered, probes, mean, p50, p95)
+    nodes = {}   # dev -> (zone, net, border, relayed, tx)
+    with open(path, errors='replace') as f:
+        for line in f:
+            m = LAT_RE.search(line)
+            if m:
+                lat[m.group(1)] = tuple(int(v) for v in m.groups()[1:])
+                continue
+            m = NODE_RE.search(line)
+            if m:
+                nodes[int(m.group(1))] = (int(m.group(2)), int(m.group(3)), bool(m.group(4)),
+                                          int(m.group(5)), int(m.group(6)))
+    return lat, nodes
+
+
+def change(base, new):
+    return f"{100 * (new - base) / base:+6.1f}%" if base else "     -"
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Subnet partitioning against a single subnet")
+    parser.add_argument('baseline', help="Console output of the single-subnet run (--zone-flat)")
+    parser.add_argument('zoned', help="Console output of the partitioned run")
+    parser.add_argument('--top', type=int, default=5, help="Busiest relays listed")
+    args = parser.parse_args()
+
+    base_lat, base_nodes = parse(args.baseline)
+    zone_lat, zone_nodes = parse(args.zoned)
+
+    for path, nodes in ((args.baseline, base_nodes), (args.zoned, zone_nodes)):
+        if not nodes:
+            sys.exit(f"Error: no zone reports in {path} (run with --zone-map)")
+
+    print("Latency [ms]    Baseline: answered  mean   p50   p95     Zoned: answered  mean   p50"
+          "   p95  p95 change")
+    for name in sorted(set(base_lat) | set(zone_lat), key=lambda n: (n.startswith('zone'), n)):
+        b = base_lat.get(name)
+        z = zone_lat.get(name)
+        b_s = f"{b[1]:>9}/{b[2]:<6} {b[3]:5d} {b[4]:5d} {b[5]:5d}" if b else f"{'-':>34}"
+        z_s = f"{z[1]:>9}/{z[2]:<6} {z[3]:5d} {z[4]:5d} {z[5]:5d}" if z else f"{'-':>34}"
+        print(f"  {name:<12} {b_s}      {z_s}  "
+              f"{change(b[5], z[5]) if b and z else '-':>10}")
+
+    print("\nRelay load per zone (PDUs relayed; mean and max per node):")
+    print("  Zone  Nodes   Baseline: total   mean    max   Zoned: total   mean    max  change")
+    for zone in sorted({n[0] for n in zone_nodes.values()}):
+        devs = [d for d, n in zone_nodes.items() if n[0] == zone and not n[2]]
+        if not devs:
+            continue
+        b = [base_nodes[d][3] for d in devs if d in base_nodes]
+        z = [zone_nodes[d][3] for d in devs]
+        print(f"  {zone:4d}  {len(devs):5d}  {sum(b):15d} {sum(b) / max(len(b), 1):6.0f} "
+              f"{max(b, default=0):6d} {sum(z):13d} {sum(z) / len(z):6.0f} {max(z):6d}  "
+              f"{change(sum(b), sum(z))}")
+
+    border = sorted(d for d, n in zone_nodes.items() if n[2])
+    if border:
+        print("\nNodes in every zone (tester and border nodes): relayed baseline -> zoned")
+        for d in border:
+            b = base_nodes.get(d, (0, 0, False, 0, 0))[3]
+            print(f"  d_{d:02d}  {b:6d} -> {zone_nodes[d][3]:6d}  {change(b, zone_nodes[d][3])}")
+
+    print("\nBusiest relays of the zoned run (baseline in brackets):")
+    for d, n in sorted(zone_nodes.items(), key=lambda x: -x[1][3])[:args.top]:
+        b = base_nodes.get(d, (0, 0, False, 0, 0))[3]
+        print(f"  d_{d:02d}  zone {n[0]}{' border' if n[2] else '       '}  {n[3]:6d}  ({b})")
+
+    b_relayed = sum(n[3] for n in base_nodes.values())
+    z_relayed = sum(n[3] for n in zone_nodes.values())
+    b_tx = sum(n[4] for n in base_nodes.values())
+    z_tx = sum(n[4] for n in zone_nodes.values())
+    print(f"\nAll nodes: relayed {b_relayed} -> {z_relayed} "
+          f"({change(b_relayed, z_relayed).strip()}), sent {b_tx} -> {z_tx} PDUs "
+          f"({change(b_tx, z_tx).strip()} channel load)")
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
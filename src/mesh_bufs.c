@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Advertising buffer pool accounting. bt_mesh_adv_create() is wrapped at link time (see
+ * CMakeLists.txt), so every allocation of the stack is seen here: the local pool
+ * (CONFIG_BT_MESH_ADV_BUF_COUNT) serves the node's own messages, the relay pool
+ * (CONFIG_BT_MESH_RELAY_BUF_COUNT) the relayed ones. The pool an allocation came from is found
+ * from the returned address, and its occupancy right after the allocation gives the high-water
+ * mark. Failed allocations are counted: relays are dropped at once when the relay pool is
+ * empty, local messages fail after waiting for a buffer.
+ */
+
+#include "mesh_test.h"
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/iterable_sections.h>
+#include "bs_tracing.h"
+#include "bsim_args_runner.h"
+
+#include "mesh/adv.h"
+
+#define LOG_MODULE_NAME mesh_bufs
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(LOG_MODULE_NAME);
+
+extern int burst_size_count;
+
+enum buf_pool {
+	BUF_POOL_LOCAL,
+	BUF_POOL_RELAY,
+	BUF_POOL_COUNT,
+};
+
+static const char *const buf_pool_names[] = { "local", "relay" };
+
+static struct {
+	struct k_mem_slab *slab;
+	uint32_t allocs;
+	uint32_t fails;
+	uint32_t max_used;
+	int64_t first_fail_ms;
+} pools[BUF_POOL_COUNT];
+
+struct bt_mesh_adv *__real_bt_mesh_adv_create(enum bt_mesh_adv_type type,
+					      enum bt_mesh_adv_tag tag, uint8_t xmit,
+					      k_timeout_t timeout);
+
+static struct k_mem_slab *slab_of(const void *block)
+{
+	STRUCT_SECTION_FOREACH(k_mem_slab, slab) {
+		const char *start = slab->buffer;
+		const char *end = start + slab->info.num_blocks * slab->info.block_size;
+
+		if ((const char *)block >= start && (const char *)block < end) {
+			return slab;
+		}
+	}
+
+	return NULL;
+}
+
+struct bt_mesh_adv *__wrap_bt_mesh_adv_create(enum bt_mesh_adv_type type,
+					      enum bt_mesh_adv_tag tag, uint8_t xmit,
+					      k_timeout_t timeout)
+{
+	struct bt_mesh_adv *adv = __real_bt_mesh_adv_create(type, tag, xmit, timeout);
+	enum buf_pool pool;
+
+	/* Friend queue messages have a pool of their own, not tracked */
+	if (tag == BT_MESH_ADV_TAG_FRIEND) {
+		return adv;
+	}
+
+	pool = tag == BT_MESH_ADV_TAG_RELAY ? BUF_POOL_RELAY : BUF_POOL_LOCAL;
+
+	if (!adv) {
+		if (!pools[pool].fails++) {
+			pools[pool].first_fail_ms = k_uptime_get();
+		}
+
+		return adv;
+	}
+
+	pools[pool].allocs++;
+
+	if (!pools[pool].slab) {
+		pools[pool].slab = slab_of(adv);
+	}
+
+	if (pools[pool].slab) {
+		pools[pool].max_used = MAX(pools[pool].max_used,
+					   k_mem_slab_num_used_get(pools[pool].slab));
+	}
+
+	return adv;
+}
+
+void bt_mesh_tst_bufs_report(void)
+{
+	static const uint32_t sizes[] = {
+		CONFIG_BT_MESH_ADV_BUF_COUNT,
+		CONFIG_BT_MESH_RELAY_BUF_COUNT,
+	};
+	int first = -1;
+
+	for (int i = 0; i < BUF_POOL_COUNT; i++) {
+		if (pools[i].fails && (first < 0 ||
+				       pools[i].first_fail_ms < pools[first].first_fail_ms)) {
+			first = i;
+		}
+	}
+
+	/* Only of interest in burst runs, or when a pool ran out */
+	if (!burst_size_count && first < 0) {
+		return;
+	}
+
+	LOG_INF("Bufs dev %d: local max %u/%u allocs %u fail %u, relay max %u/%u allocs %u "
+		"fail %u, first out %s at %lld ms", bsim_args_get_global_device_nbr(),
+		pools[BUF_POOL_LOCAL].max_used, sizes[BUF_POOL_LOCAL],
+		pools[BUF_POOL_LOCAL].allocs, pools[BUF_POOL_LOCAL].fails,
+		pools[BUF_POOL_RELAY].max_used, sizes[BUF_POOL_RELAY],
+		pools[BUF_POOL_RELAY].allocs, pools[BUF_POOL_RELAY].fails,
+		first < 0 ? "none" : buf_pool_names[first],
+		first < 0 ? -1LL : pools[first].first_fail_ms);
+}
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Replay protection list and message cache pressure. bt_mesh_rpl_check() and bt_mesh_adv_send()
+ * are wrapped at link time (see CMakeLists.txt).
+ *
+ * The RPL (CONFIG_BT_MESH_CRPL entries) rejects a message either because it is a replay, or
+ * because the list is full and the source has no entry. A rejection from a source the RPL never
+ * accepted before can only be the latter. Once the message cache
+ * (CONFIG_BT_MESH_MSG_CACHE_SIZE entries) has evicted a message, a late copy of it passes the
+ * cache again: when addressed to this node the RPL rejects it as a replay, otherwise the node
+ * relays it a second time. Relayed PDUs are deobfuscated and looked up in a window much larger
+ * than the cache to count these duplicate relays.
+ */
+
+#include "mesh_test.h"
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/atomic.h>
+#include "bs_tracing.h"
+#include "bsim_args_runner.h"
+
+#include "mesh/net.h"
+#include "mesh/rpl.h"
+#include "mesh/adv.h"
+
+#define LOG_MODULE_NAME mesh_cache
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(LOG_MODULE_NAME);
+
+extern int cc_group;
+
+/* Relayed messages remembered to detect duplicate relays, 8 times the message cache */
+#define RELAY_WINDOW (8 * CONFIG_BT_MESH_MSG_CACHE_SIZE)
+
+struct relay_rec {
+	uint32_t seq;
+	uint16_t src;
+};
+
+static ATOMIC_DEFINE(rpl_seen, MAX_DEVICES);
+static struct relay_rec relay_window[RELAY_WINDOW];
+static uint32_t relay_head;
+static struct bt_mesh_tst_cache_stats stats;
+
+bool __real_bt_mesh_rpl_check(struct bt_mesh_net_rx *rx, struct bt_mesh_rpl **match,
+			      bool bridge);
+void __real_bt_mesh_adv_send(struct bt_mesh_adv *adv, const struct bt_mesh_send_cb *cb,
+			     void *cb_data);
+
+bool __wrap_bt_mesh_rpl_check(struct bt_mesh_net_rx *rx, struct bt_mesh_rpl **match,
+			      bool bridge)
+{
+	uint16_t src = rx->ctx.addr;
+	bool reject = __real_bt_mesh_rpl_check(rx, match, bridge);
+
+	/* Only the test nodes' unicast addresses are tracked, and only when the real check
+	 * consulted the list: it passes local and not-for-us messages without an entry
+	 */
+	if (src < 1 || src > MAX_DEVICES || !rx->local_match ||
+	    rx->net_if == BT_MESH_NET_IF_LOCAL) {
+		return reject;
+	}
+
+	if (!reject) {
+		if (!atomic_test_and_set_bit(rpl_seen, src - 1)) {
+			stats.rpl_sources++;
+		}
+	} else if (atomic_test_bit(rpl_seen, src - 1)) {
+		stats.rpl_replay++;
+	} else {
+		stats.rpl_full++;
+	}
+
+	return reject;
+}
+
+static bool relay_seen(uint16_t src, uint32_t seq)
+{
+	uint32_t n = MIN(relay_head, RELAY_WINDOW);
+
+	for (uint32_t i = 1; i <= n; i++) {
+		const struct relay_rec *rec = &relay_window[(relay_head - i) % RELAY_WINDOW];
+
+		if (rec->src == src && rec->seq == seq) {
+			return true;
+		}
+	}
+
+	relay_window[relay_head++ % RELAY_WINDOW] = (struct relay_rec){ .src = src, .seq = seq };
+
+	return false;
+}
+
+void __wrap_bt_mesh_adv_send(struct bt_mesh_adv *adv, const struct bt_mesh_send_cb *cb,
+			     void *cb_data)
+{
+	uint8_t hdr[7];
+
+	if (adv->ctx.tag == BT_MESH_ADV_TAG_RELAY && adv->ctx.type == BT_MESH_ADV_DATA &&
+	    bt_mesh_tst_net_hdr_deobfuscate(adv->b.data, adv->b.len, hdr)) {
+		stats.relayed++;
+
+		if (relay_seen(sys_get_be16(&hdr[5]), sys_get_be24(&hdr[2]))) {
+			stats.dup_relayed++;
+		}
+	}
+
+	__real_bt_mesh_adv_send(adv, cb, cb_data);
+}
+
+void bt_mesh_tst_cache_stats_get(struct bt_mesh_tst_cache_stats *st)
+{
+	*st = stats;
+}
+
+void bt_mesh_tst_cache_report(void)
+{
+	struct bt_mesh_statistic st;
+
+	/* Only of interest in group convergecast runs, or when the RPL or cache overflowed */
+	if (!cc_group && !stats.rpl_full && !stats.dup_relayed) {
+		return;
+	}
+
+	bt_mesh_stat_get(&st);
+
+	LOG_INF("Cache dev %d: crpl %d cache %d, sources %u rpl full %u replays %u, relayed %u "
+		"duplicate %u, tx %u", bsim_args_get_global_device_nbr(), CONFIG_BT_MESH_CRPL,
+		CONFIG_BT_MESH_MSG_CACHE_SIZE, stats.rpl_sources, stats.rpl_full,
+		stats.rpl_replay, stats.relayed, stats.dup_relayed,
+		st.tx_local_succeeded + st.tx_adv_relay_succeeded);
+}
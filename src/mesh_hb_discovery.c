@@ -0,0 +1,225 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Hop count discovery with heartbeats, run by every node before the measurement starts.
+ *
+ * A node can only subscribe to heartbeats from one source at a time, so the sources take turns
+ * in fixed time slots: in slot i, device i publishes hb_count heartbeats with TTL MAX_TTL to
+ * all nodes, and all other nodes subscribe to it. Each node ends up with the min/max hop count
+ * from every source, and logs it as one row of the hop matrix. Testers also log the hop count
+ * from every device to themselves. helper_hop_matrix.py assembles the rows from the console
+ * output and compares them with the topology file.
+ */
+
+#include "mesh_test.h"
+
+#include <stdio.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/math_extras.h>
+#include "bs_tracing.h"
+#include "bsim_args_runner.h"
+
+#define LOG_MODULE_NAME mesh_hb_discovery
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(LOG_MODULE_NAME);
+
+extern int hb_slot_ms;
+extern int hb_count;
+extern int node_count;
+extern uint8_t net_idx;
+
+/* All nodes are configured well before this uptime, and the clocks of all devices match */
+#define HB_START_MS (5000)
+
+/* Subscriptions are in place this long before the source publishes */
+#define HB_SUB_LEAD_MS (20)
+
+/* 16 s subscription and 1 s publication periods (log values), longer than any slot needs */
+#define HB_SUB_PERIOD_LOG (5)
+#define HB_PUB_PERIOD_LOG (1)
+
+struct hb_hops {
+	uint8_t min;
+	uint8_t max;
+	uint16_t count;
+};
+
+static struct hb_hops hb_from[MAX_DEVICES + 1];
+
+static void hb_recv(const struct bt_mesh_hb_sub *sub, uint8_t hops, uint16_t feat)
+{
+	struct hb_hops *from;
+
+	ARG_UNUSED(feat);
+
+	if (sub->src < 1 || sub->src > MAX_DEVICES + 1) {
+		return;
+	}
+
+	from = &hb_from[sub->src - 1];
+	from->min = from->count ? MIN(from->min, hops) : hops;
+	from->max = MAX(from->max, hops);
+	from->count++;
+}
+
+BT_MESH_HB_CB_DEFINE(hb_discovery_cb) = {
+	.recv = hb_recv,
+};
+
+static void sleep_until(int64_t uptime_ms)
+{
+	int64_t now = k_uptime_get();
+
+	if (uptime_ms > now) {
+		k_sleep(K_MSEC(uptime_ms - now));
+	}
+}
+
+static int hb_sub_set(uint16_t addr, uint16_t src, uint8_t period_log)
+{
+	struct bt_mesh_cfg_cli_hb_sub sub = {
+		.src = src,
+		.dst = BT_MESH_ADDR_ALL_NODES,
+		.period = period_log,
+	};
+	uint8_t status;
+	int err;
+
+	err = bt_mesh_cfg_cli_hb_sub_set(net_idx, addr, &sub, &status);
+
+	return err ? err : status;
+}
+
+static int hb_pub_set(uint16_t addr)
+{
+	struct bt_mesh_cfg_cli_hb_pub pub = {
+		.dst = BT_MESH_ADDR_ALL_NODES,
+		/* count = 2^(log - 1), hb_count is a power of two */
+		.count = 1 + u32_count_trailing_zeros(hb_count),
+		.period = HB_PUB_PERIOD_LOG,
+		.ttl = MAX_TTL,
+		.net_idx = net_idx,
+	};
+	uint8_t status;
+	int err;
+
+	err = bt_mesh_cfg_cli_hb_pub_set(net_idx, addr, &pub, &status);
+
+	return err ? err : status;
+}
+
+static void hb_row_print(uint16_t addr)
+{
+	static char line[MAX_DEVICES * 8 + 32];
+	int offset;
+
+	offset = snprintf(line, sizeof(line), "HB row %d:", addr - 1);
+
+	for (int i = 0; i < node_count && offset < sizeof(line); i++) {
+		const struct hb_hops *from = &hb_from[i];
+
+		if (i == addr - 1) {
+			offset += snprintf(line + offset, sizeof(line) - offset, " 0");
+		} else if (!from->count) {
+			offset += snprintf(line + offset, sizeof(line) - offset, " -");
+		} else {
+			offset += snprintf(line + offset, sizeof(line) - offset, " %u/%u",
+					   from->min, from->max);
+		}
+	}
+
+	LOG_INF("%s", line);
+}
+
+static void hb_tester_report(uint16_t addr)
+{
+	int heard = 0;
+	int max_hops = 0;
+
+	LOG_INF("Heartbeat hop counts to the tester (0x%04x), %d heartbeats per device:", addr,
+		hb_count);
+
+	for (int i = 0; i < node_count; i++) {
+		const struct hb_hops *from = &hb_from[i];
+
+		if (i == addr - 1) {
+			continue;
+		}
+
+		if (!from->count) {
+			LOG_WRN("HB Dev %d addr 0x%04x not heard", i, i + 1);
+			continue;
+		}
+
+		heard++;
+		max_hops = MAX(max_hops, from->max);
+		LOG_INF("HB Dev %d addr 0x%04x hops min %u max %u heartbeats %u/%d", i, i + 1,
+			from->min, from->max, from->count, hb_count);
+	}
+
+	LOG_INF("HB discovery: %d of %d devices heard, up to %d hops, %d ms", heard,
+		node_count - 1, max_hops, node_count * hb_slot_ms);
+}
+
+void bt_mesh_tst_hb_discovery(uint16_t addr, bool tester)
+{
+	int err;
+
+	if (!hb_slot_ms) {
+		return;
+	}
+
+	if (node_count < 2 || node_count > MAX_DEVICES || addr > node_count) {
+		FAIL("Heartbeat discovery needs the node count (nodes=%d)", node_count);
+		return;
+	}
+
+	if (k_uptime_get() > HB_START_MS) {
+		FAIL("Heartbeat discovery can not start at %d ms, configuration took too long",
+		     HB_START_MS);
+		return;
+	}
+
+	bt_mesh_tst_prof_phase("discovery");
+
+	for (int slot = 0; slot < node_count; slot++) {
+		int64_t slot_start = HB_START_MS + (int64_t)slot * hb_slot_ms;
+		uint16_t src = slot + 1;
+
+		sleep_until(slot_start);
+
+		if (src != addr) {
+			/* A new subscription replaces the one of the previous slot */
+			err = hb_sub_set(addr, src, HB_SUB_PERIOD_LOG);
+			if (err) {
+				LOG_ERR("Heartbeat subscription to 0x%04x failed (err %d)", src,
+					err);
+			}
+
+			continue;
+		}
+
+		sleep_until(slot_start + HB_SUB_LEAD_MS);
+
+		err = hb_pub_set(addr);
+		if (err) {
+			LOG_ERR("Heartbeat publication failed (err %d)", err);
+		}
+	}
+
+	sleep_until(HB_START_MS + (int64_t)node_count * hb_slot_ms);
+
+	err = hb_sub_set(addr, BT_MESH_ADDR_UNASSIGNED, 0);
+	if (err) {
+		LOG_ERR("Heartbeat subscription clear failed (err %d)", err);
+	}
+
+	hb_row_print(addr);
+
+	if (tester) {
+		hb_tester_report(addr);
+	}
+}
@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Observed link table. The scanner sees every advertisement with its RSSI, and the identity
+ * address tells which test node sent it (see bt_mesh_tst_id_addr_dev()). Per sender, the
+ * packet count and RSSI min/sum/max are kept. At exit, every node logs its table as one row of
+ * the observed link matrix, and helper_link_matrix.py compares the matrix with the attenuation
+ * of the topology file. Only the overlay_id_addr.conf build has identity addresses to tell the
+ * senders apart.
+ */
+
+#include "mesh_test.h"
+
+#include <stdio.h>
+#include <zephyr/kernel.h>
+#include "bs_tracing.h"
+#include "bsim_args_runner.h"
+
+#define LOG_MODULE_NAME mesh_links
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(LOG_MODULE_NAME);
+
+struct link_stats {
+	uint32_t count;
+	int64_t rssi_sum;
+	int8_t rssi_min;
+	int8_t rssi_max;
+};
+
+static struct link_stats links[MAX_DEVICES];
+
+void bt_mesh_tst_links_adv(const struct bt_le_scan_recv_info *info)
+{
+	int tx = bt_mesh_tst_id_addr_dev(info->addr);
+	struct link_stats *link;
+
+	if (tx < 0 || tx >= MAX_DEVICES) {
+		return;
+	}
+
+	link = &links[tx];
+	link->rssi_min = link->count ? MIN(link->rssi_min, info->rssi) : info->rssi;
+	link->rssi_max = link->count ? MAX(link->rssi_max, info->rssi) : info->rssi;
+	link->rssi_sum += info->rssi;
+	link->count++;
+}
+
+void bt_mesh_tst_links_report(void)
+{
+	/* Up to 29 characters per sender: " 99:4294967295/-128/-128/-128" */
+	static char line[MAX_DEVICES * 30 + 32];
+	int dev = bsim_args_get_global_device_nbr();
+	int offset;
+
+	/* Without identity addresses no sender is known */
+	if (!IS_ENABLED(CONFIG_BT_MESH_DEBUG_USE_ID_ADDR)) {
+		return;
+	}
+
+	offset = snprintf(line, sizeof(line), "Links dev %d:", dev);
+
+	for (int tx = 0; tx < MAX_DEVICES && offset < sizeof(line); tx++) {
+		const struct link_stats *link = &links[tx];
+
+		if (!link->count) {
+			continue;
+		}
+
+		/* Mean rounded away from zero, RSSI values are negative */
+		offset += snprintf(line + offset, sizeof(line) - offset, " %d:%u/%d/%d/%d", tx,
+				   link->count, link->rssi_min,
+				   (int)((link->rssi_sum - link->count / 2) / (int64_t)link->count),
+				   link->rssi_max);
+	}
+
+	LOG_INF("%s", line);
+}
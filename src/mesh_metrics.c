@@ -0,0 +1,239 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Live progress metrics of a tester, periodically written in the Prometheus text exposition
+ * format to the file given with metrics_file. The file can be watched directly, or picked up
+ * by the node_exporter textfile collector when it is placed in the collector directory.
+ */
+
+#include "mesh_test.h"
+#include "native/mesh_host.h"
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <zephyr/kernel.h>
+#include "bs_tracing.h"
+#include "bsim_args_runner.h"
+
+#define LOG_MODULE_NAME mesh_metrics
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(LOG_MODULE_NAME);
+
+extern char *metrics_file;
+extern int metrics_period_ms;
+extern int max_iterations;
+
+/* Latency histogram for the running percentiles, the last bin collects everything above */
+#define METRICS_HIST_BIN_MS (10)
+#define METRICS_HIST_BINS   (1000)
+
+static struct {
+	int duts_total;
+	int duts_done;
+	uint32_t probes;
+	uint32_t failures;
+	int64_t latency_sum;
+	uint32_t hist[METRICS_HIST_BINS];
+	int64_t last_probe_ms;
+	int64_t start_sim_ms;
+	int64_t start_wall_us;
+	int64_t prev_sim_ms;
+	int64_t prev_wall_us;
+	bool done;
+} metrics;
+
+/* The text without the simid labels (values at their longest), and the 18 labelled values */
+#define METRICS_FIXED_LEN   (2816)
+#define METRICS_VALUE_COUNT (18)
+#define METRICS_SIMID_MAX   (64)
+
+static char metrics_buf[METRICS_FIXED_LEN + METRICS_VALUE_COUNT * METRICS_SIMID_MAX];
+static size_t metrics_off;
+static bool metrics_truncated;
+static struct k_work_delayable metrics_work;
+
+static uint32_t hist_quantile(int permille)
+{
+	uint32_t count = metrics.probes - metrics.failures;
+	uint32_t rank = (count * permille + 999) / 1000;
+	uint32_t seen = 0;
+
+	if (!count) {
+		return 0;
+	}
+
+	for (int i = 0; i < METRICS_HIST_BINS; i++) {
+		seen += metrics.hist[i];
+		if (seen >= MAX(rank, 1)) {
+			/* Upper edge of the bin, so the quantile is never underestimated */
+			return (i + 1) * METRICS_HIST_BIN_MS;
+		}
+	}
+
+	return METRICS_HIST_BINS * METRICS_HIST_BIN_MS;
+}
+
+/* Append to metrics_buf. Once the text no longer fits, nothing more is written and the
+ * update is flagged as truncated.
+ */
+static void metrics_append(const char *fmt, ...)
+{
+	va_list args;
+	int len;
+
+	if (metrics_truncated) {
+		return;
+	}
+
+	va_start(args, fmt);
+	len = vsnprintf(metrics_buf + metrics_off, sizeof(metrics_buf) - metrics_off, fmt, args);
+	va_end(args);
+
+	if (len < 0 || len >= sizeof(metrics_buf) - metrics_off) {
+		metrics_truncated = true;
+		return;
+	}
+
+	metrics_off += len;
+}
+
+#define METRIC(name, type, help)                                                        \
+	metrics_append("# HELP mesh_sim_" name " " help "\n# TYPE mesh_sim_" name " " type "\n")
+
+#define VALUE(name, labels, fmt, ...)                                                   \
+	metrics_append("mesh_sim_" name "{simid=\"%s\",dev=\"%d\"" labels "} " fmt "\n", \
+		       simid, dev, ##__VA_ARGS__)
+
+static void metrics_write(void)
+{
+	const char *simid = bsim_args_get_simid();
+	int dev = bsim_args_get_global_device_nbr();
+	int64_t sim_ms = k_uptime_get();
+	int64_t wall_us = mesh_host_wall_time_us();
+	int64_t run_sim_ms = sim_ms - metrics.start_sim_ms;
+	int64_t run_wall_us = MAX(wall_us - metrics.start_wall_us, 1);
+	int64_t recent_wall_us = MAX(wall_us - metrics.prev_wall_us, 1);
+	int err;
+
+	metrics_off = 0;
+	metrics_truncated = false;
+
+	METRIC("duts_total", "gauge", "DUTs the tester will measure");
+	VALUE("duts_total", "", "%d", metrics.duts_total);
+	METRIC("duts_done", "gauge", "DUTs measured so far");
+	VALUE("duts_done", "", "%d", metrics.duts_done);
+	METRIC("iterations_planned", "gauge", "Probes the tester will send in total");
+	VALUE("iterations_planned", "", "%d", metrics.duts_total * max_iterations);
+	METRIC("iterations_total", "counter", "Probes completed so far");
+	VALUE("iterations_total", "", "%u", metrics.probes);
+	METRIC("failures_total", "counter", "Probes without a response");
+	VALUE("failures_total", "", "%u", metrics.failures);
+
+	METRIC("latency_ms", "summary", "Round-trip latency of the answered probes");
+	VALUE("latency_ms", ",quantile=\"0.5\"", "%u", hist_quantile(500));
+	VALUE("latency_ms", ",quantile=\"0.95\"", "%u", hist_quantile(950));
+	VALUE("latency_ms", ",quantile=\"0.99\"", "%u", hist_quantile(990));
+	VALUE("latency_ms_sum", "", "%lld", metrics.latency_sum);
+	VALUE("latency_ms_count", "", "%u", metrics.probes - metrics.failures);
+
+	METRIC("simulated_seconds", "gauge", "Simulated time since the tester started measuring");
+	VALUE("simulated_seconds", "", "%lld.%03lld", run_sim_ms / 1000, run_sim_ms % 1000);
+	METRIC("wall_seconds", "gauge", "Wall-clock time since the tester started measuring");
+	VALUE("wall_seconds", "", "%lld.%03lld", run_wall_us / USEC_PER_SEC,
+	      run_wall_us % USEC_PER_SEC / 1000);
+	METRIC("cpu_seconds", "gauge", "CPU time used by the tester process");
+	VALUE("cpu_seconds", "", "%lld.%03lld", mesh_host_cpu_time_us() / USEC_PER_SEC,
+	      mesh_host_cpu_time_us() % USEC_PER_SEC / 1000);
+	METRIC("speed_ratio_permille", "gauge",
+	       "Simulated over wall-clock time x1000, since start and over the last period");
+	VALUE("speed_ratio_permille", ",window=\"run\"", "%lld",
+	      run_sim_ms * 1000000 / run_wall_us);
+	VALUE("speed_ratio_permille", ",window=\"recent\"", "%lld",
+	      (sim_ms - metrics.prev_sim_ms) * 1000000 / recent_wall_us);
+	METRIC("since_progress_seconds", "gauge", "Simulated time since the last probe completed");
+	VALUE("since_progress_seconds", "", "%lld", (sim_ms - metrics.last_probe_ms) / 1000);
+	METRIC("done", "gauge", "1 once the tester has finished measuring");
+	VALUE("done", "", "%d", metrics.done);
+	METRIC("last_update_timestamp_seconds", "gauge", "Host time of this update");
+	VALUE("last_update_timestamp_seconds", "", "%lld", mesh_host_unix_time_s());
+
+	metrics.prev_sim_ms = sim_ms;
+	metrics.prev_wall_us = wall_us;
+
+	if (metrics_truncated) {
+		LOG_ERR("Metrics buffer of %zu bytes too small (simid up to %d characters)",
+			sizeof(metrics_buf), METRICS_SIMID_MAX);
+		return;
+	}
+
+	err = mesh_host_write_file(metrics_file, metrics_buf, metrics_off);
+	if (err) {
+		LOG_WRN("Writing metrics to %s failed (err %d)", metrics_file, err);
+	}
+}
+
+static void metrics_work_handler(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	metrics_write();
+
+	if (!metrics.done) {
+		k_work_schedule(&metrics_work, K_MSEC(metrics_period_ms));
+	}
+}
+
+void bt_mesh_tst_metrics_plan(int duts)
+{
+	if (!metrics_file) {
+		return;
+	}
+
+	if (!metrics.duts_total) {
+		metrics.start_sim_ms = k_uptime_get();
+		metrics.start_wall_us = mesh_host_wall_time_us();
+		metrics.prev_sim_ms = metrics.start_sim_ms;
+		metrics.prev_wall_us = metrics.start_wall_us;
+		metrics.last_probe_ms = metrics.start_sim_ms;
+
+		LOG_INF("Publishing metrics to %s every %d ms", metrics_file, metrics_period_ms);
+
+		k_work_init_delayable(&metrics_work, metrics_work_handler);
+		k_work_schedule(&metrics_work, K_NO_WAIT);
+	}
+
+	metrics.duts_total += duts;
+}
+
+void bt_mesh_tst_metrics_probe(int64_t latency_ms, bool ok)
+{
+	metrics.probes++;
+	metrics.last_probe_ms = k_uptime_get();
+
+	if (!ok) {
+		metrics.failures++;
+		return;
+	}
+
+	metrics.latency_sum += latency_ms;
+	metrics.hist[MIN(latency_ms / METRICS_HIST_BIN_MS, METRICS_HIST_BINS - 1)]++;
+}
+
+void bt_mesh_tst_metrics_dut_done(void)
+{
+	metrics.duts_done++;
+}
+
+void bt_mesh_tst_metrics_finish(void)
+{
+	if (!metrics_file || !metrics.duts_total) {
+		return;
+	}
+
+	metrics.done = true;
+	k_work_cancel_delayable(&metrics_work);
+	metrics_write();
+}
@@ -0,0 +1,408 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "mesh_test.h"
+
+#include <zephyr/kernel.h>
+#include <zephyr/random/random.h>
+#include <zephyr/sys/byteorder.h>
+#include "bs_tracing.h"
+#include "bs_utils.h"
+#include "bsim_args_runner.h"
+
+#define LOG_MODULE_NAME mesh_nw_cc
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(LOG_MODULE_NAME);
+
+extern int dut_list[MAX_DEVICES];
+extern int dut_count;
+
+extern int cc_periods[CC_MAX_PHASES];
+extern int cc_phase_count;
+extern int cc_phase_ms;
+extern int cc_jitter_ms;
+extern int cc_len;
+extern int cc_sink;
+extern int cc_sat_pct;
+extern int cc_group;
+
+/* All devices have finished self provisioning and configuration by then */
+#define CC_START_MS (10000)
+
+/* Time after the last phase for in-flight messages to reach the sink */
+#define CC_DRAIN_MS (5000)
+
+#define WAIT_TIME ((CC_START_MS + cc_phase_count * cc_phase_ms + CC_DRAIN_MS) / 1000 * 2)
+
+/* Latency histogram resolution and range, used for the per-phase percentiles */
+#define CC_HIST_BIN_MS (10)
+#define CC_HIST_BINS (500)
+
+/* Report message: phase (1), per-source sequence number (2), send uptime in ms (4), padding */
+#define CC_HDR_LEN (7)
+#define CC_MODEL_ID (0x0c0c)
+#define CC_OP_REPORT BT_MESH_MODEL_OP_3(0x0c, CONFIG_BT_COMPANY_ID)
+
+/* With cc_group, reports go to this group. Every node subscribes, so every node's RPL has to
+ * hold all sources, not just the sink's.
+ */
+#define CC_GROUP_ADDR (0xc200)
+
+extern enum bst_result_t bst_result;
+
+extern uint8_t app_idx;
+extern uint8_t net_idx;
+
+/* Per-source reception bookkeeping on the sink */
+struct cc_src_stats {
+	uint32_t rx[CC_MAX_PHASES];
+	int64_t lat_sum[CC_MAX_PHASES];
+	uint32_t lat_max[CC_MAX_PHASES];
+	uint8_t max_recv_ttl;
+};
+
+static struct cc_src_stats cc_src[MAX_DEVICES];
+static uint32_t cc_hist[CC_MAX_PHASES][CC_HIST_BINS];
+
+/* Per-phase send bookkeeping on the sources */
+static uint32_t cc_sent[CC_MAX_PHASES];
+static uint32_t cc_send_err[CC_MAX_PHASES];
+
+static int cc_report_recv(const struct bt_mesh_model *model, struct bt_mesh_msg_ctx *ctx,
+			  struct net_buf_simple *buf)
+{
+	uint8_t phase = net_buf_simple_pull_u8(buf);
+	uint16_t seq = net_buf_simple_pull_le16(buf);
+	uint32_t sent_ms = net_buf_simple_pull_le32(buf);
+	/* All devices share the simulated time base, so one-way latency can be measured */
+	uint32_t latency = (uint32_t)k_uptime_get() - sent_ms;
+	struct cc_src_stats *src;
+
+	if (phase >= cc_phase_count || ctx->addr < 1 || ctx->addr > MAX_DEVICES) {
+		LOG_WRN("Unexpected report from 0x%04x phase %u", ctx->addr, phase);
+		return 0;
+	}
+
+	src = &cc_src[ctx->addr - 1];
+	src->rx[phase]++;
+	src->lat_sum[phase] += latency;
+	src->lat_max[phase] = MAX(src->lat_max[phase], latency);
+	src->max_recv_ttl = MAX(src->max_recv_ttl, ctx->recv_ttl);
+	cc_hist[phase][MIN(latency / CC_HIST_BIN_MS, CC_HIST_BINS - 1)]++;
+
+	LOG_DBG("Report 0x%04x phase %u seq %u latency %u ttl %u", ctx->addr, phase, seq, latency,
+		ctx->recv_ttl);
+
+	return 0;
+}
+
+static const struct bt_mesh_model_op cc_ops[] = {
+	{ CC_OP_REPORT, BT_MESH_LEN_MIN(CC_HDR_LEN), cc_report_recv },
+	BT_MESH_MODEL_OP_END,
+};
+
+static struct bt_mesh_prov prov;
+static struct bt_mesh_cfg_cli cfg_cli;
+
+static const struct bt_mesh_elem elems[] = {
+	BT_MESH_ELEM(1,
+		MODEL_LIST(BT_MESH_MODEL_CFG_SRV,
+			   BT_MESH_MODEL_CFG_CLI(&cfg_cli)),
+		MODEL_LIST(BT_MESH_MODEL_VND_CB(CONFIG_BT_COMPANY_ID, CC_MODEL_ID, cc_ops, NULL,
+						NULL, NULL))),
+};
+
+static const struct bt_mesh_comp comp = {
+	.elem = elems,
+	.elem_count = ARRAY_SIZE(elems),
+};
+
+static void additional_configure(uint16_t addr)
+{
+	uint8_t status;
+	int err;
+
+	err = bt_mesh_cfg_cli_mod_app_bind_vnd(net_idx, addr, addr, app_idx, CC_MODEL_ID,
+					       CONFIG_BT_COMPANY_ID, &status);
+	if (err || status) {
+		FAIL("Model 0x%04x bind failed (err %d, status %u)", CC_MODEL_ID, err, status);
+	}
+
+	if (!cc_group) {
+		return;
+	}
+
+	err = bt_mesh_cfg_cli_mod_sub_add_vnd(net_idx, addr, addr, CC_GROUP_ADDR, CC_MODEL_ID,
+					      CONFIG_BT_COMPANY_ID, &status);
+	if (err || status) {
+		FAIL("Model 0x%04x subscription failed (err %d, status %u)", CC_MODEL_ID, err,
+		     status);
+	}
+}
+
+static void dev_prov_and_conf(uint16_t addr)
+{
+	/* Do self provisioning and configuration to keep test bench simple. */
+	bt_mesh_tst_provision(addr);
+	bt_mesh_tst_common_configure(addr);
+	additional_configure(addr);
+}
+
+static void sleep_until(int64_t uptime_ms)
+{
+	int64_t now = k_uptime_get();
+
+	if (uptime_ms > now) {
+		k_sleep(K_MSEC(uptime_ms - now));
+	}
+}
+
+/* Number of reports each source sends in a phase. Exact, so the sink knows what was offered. */
+static uint32_t phase_msg_count(int phase)
+{
+	return cc_phase_ms / cc_periods[phase];
+}
+
+static int report_send(uint16_t dst, uint8_t phase, uint16_t seq)
+{
+	BT_MESH_MODEL_BUF_DEFINE(msg, CC_OP_REPORT, CC_HDR_LEN + CC_MAX_LEN);
+	struct bt_mesh_msg_ctx ctx = {
+		.net_idx = net_idx,
+		.app_idx = app_idx,
+		.addr = dst,
+		.send_ttl = MAX_TTL,
+	};
+
+	bt_mesh_model_msg_init(&msg, CC_OP_REPORT);
+	net_buf_simple_add_u8(&msg, phase);
+	net_buf_simple_add_le16(&msg, seq);
+	net_buf_simple_add_le32(&msg, (uint32_t)k_uptime_get());
+	memset(net_buf_simple_add(&msg, cc_len - CC_HDR_LEN), 0, cc_len - CC_HDR_LEN);
+
+	return bt_mesh_model_send(&elems[0].vnd_models[0], &ctx, &msg, NULL, NULL);
+}
+
+static void test_cc_node_device_init(void)
+{
+	bt_mesh_test_cfg_set(WAIT_TIME);
+}
+
+static void test_cc_node_device(void)
+{
+	uint16_t addr = bsim_args_get_global_device_nbr() + 1;
+	uint16_t dst = cc_group ? CC_GROUP_ADDR : cc_sink + 1;
+	struct bt_mesh_statistic st_start, st_end;
+	struct bt_mesh_tst_cache_stats cs_start, cs_end;
+	uint16_t seq = 0;
+
+	bst_result = In_progress;
+	LOG_INF("Hello :simid %s nbr %d", bsim_args_get_simid(), bsim_args_get_global_device_nbr());
+
+	bt_mesh_device_setup(&prov, &comp);
+	dev_prov_and_conf(addr);
+	bt_mesh_tst_prof_phase("measurement");
+
+	PASS();
+
+	if (!is_dut(addr - 1, dut_list, dut_count)) {
+		/* Relay only */
+		return;
+	}
+
+	for (int phase = 0; phase < cc_phase_count; phase++) {
+		int64_t phase_start = CC_START_MS + (int64_t)phase * cc_phase_ms;
+		int jitter = MIN(cc_jitter_ms, cc_periods[phase]);
+
+		sleep_until(phase_start);
+		bt_mesh_stat_get(&st_start);
+		bt_mesh_tst_cache_stats_get(&cs_start);
+
+		for (uint32_t i = 0; i < phase_msg_count(phase); i++) {
+			int err;
+
+			sleep_until(phase_start + (int64_t)i * cc_periods[phase] +
+				    (jitter ? sys_rand32_get() % jitter : 0));
+
+			err = report_send(dst, phase, seq++);
+			if (err) {
+				/* E.g. all segmented TX contexts busy: the report never left */
+				cc_send_err[phase]++;
+				continue;
+			}
+
+			cc_sent[phase]++;
+		}
+
+		sleep_until(phase_start + cc_phase_ms);
+		bt_mesh_stat_get(&st_end);
+		bt_mesh_tst_cache_stats_get(&cs_end);
+
+		LOG_INF("CC phase %d: sent %u send errors %u relayed %u, rpl full %u duplicate "
+			"relays %u", phase, cc_sent[phase], cc_send_err[phase],
+			st_end.tx_adv_relay_planned - st_start.tx_adv_relay_planned,
+			cs_end.rpl_full - cs_start.rpl_full,
+			cs_end.dup_relayed - cs_start.dup_relayed);
+	}
+}
+
+/* Jain's fairness index of x[0..n-1], scaled by 1000 */
+static uint32_t jain_index_permille(const uint32_t *x, int n)
+{
+	uint64_t sum = 0, sum_sq = 0;
+
+	for (int i = 0; i < n; i++) {
+		sum += x[i];
+		sum_sq += (uint64_t)x[i] * x[i];
+	}
+
+	return sum_sq ? (uint32_t)(sum * sum * 1000 / (n * sum_sq)) : 1000;
+}
+
+static void cc_print_results(int total_nodes)
+{
+	static uint32_t ratio[MAX_DEVICES];
+	int saturated = -1;
+
+	LOG_INF("Convergecast to sink 0x%04x%s, %d sources, %d ms phases", cc_sink + 1,
+		cc_group ? " via group" : "", total_nodes - 1, cc_phase_ms);
+
+	for (int phase = 0; phase < cc_phase_count; phase++) {
+		uint32_t expected = phase_msg_count(phase);
+		uint32_t rx = 0, adj_rx = 0, adj_expected = 0;
+		int n = 0;
+
+		for (int dev = 0; dev < total_nodes; dev++) {
+			struct cc_src_stats *src = &cc_src[dev];
+
+			if (dev == cc_sink || !is_dut(dev, dut_list, dut_count)) {
+				continue;
+			}
+
+			ratio[n++] = src->rx[phase] * 1000 / MAX(expected, 1);
+			rx += src->rx[phase];
+
+			/* Heard without any relay hop: a neighbour of the sink */
+			if (src->max_recv_ttl == MAX_TTL) {
+				adj_rx += src->rx[phase];
+				adj_expected += expected;
+			}
+		}
+
+		uint32_t offered = n * expected;
+		uint32_t delivery = rx * 1000 / MAX(offered, 1);
+		uint32_t adj_delivery = adj_rx * 1000 / MAX(adj_expected, 1);
+		uint32_t jain = jain_index_permille(ratio, n);
+		uint32_t p50 = bt_mesh_tst_hist_percentile(cc_hist[phase], CC_HIST_BINS,
+							   CC_HIST_BIN_MS, rx, 50);
+		uint32_t p95 = bt_mesh_tst_hist_percentile(cc_hist[phase], CC_HIST_BINS,
+							   CC_HIST_BIN_MS, rx, 95);
+
+		LOG_INF("CC phase %d: period %d ms, offered %u msg/min, delivered %u/%u (%u.%u%%)",
+			phase, cc_periods[phase], offered * 60000 / cc_phase_ms, rx, offered,
+			delivery / 10, delivery % 10);
+		LOG_INF("CC phase %d: latency p50 %u ms p95 %u ms, Jain %u.%03u, "
+			"sink neighbours delivered %u.%u%%", phase, p50, p95, jain / 1000,
+			jain % 1000, adj_delivery / 10, adj_delivery % 10);
+
+		/* Saturation shows first at the sink's neighbours, which carry all relayed reports.
+		 * Without any neighbour, fall back to the overall delivery.
+		 */
+		if (saturated < 0 && (adj_expected ? adj_delivery : delivery) < cc_sat_pct * 10) {
+			saturated = phase;
+		}
+	}
+
+	for (int dev = 0; dev < total_nodes; dev++) {
+		struct cc_src_stats *src = &cc_src[dev];
+		char line[CC_MAX_PHASES * 24 + 64];
+		int offset;
+
+		if (dev == cc_sink || !is_dut(dev, dut_list, dut_count)) {
+			continue;
+		}
+
+		offset = snprintf(line, sizeof(line), "CC src %d addr 0x%04x hops %d:", dev,
+				  dev + 1, src->max_recv_ttl ? MAX_TTL - src->max_recv_ttl + 1 : -1);
+
+		for (int phase = 0; phase < cc_phase_count; phase++) {
+			offset += snprintf(line + offset, sizeof(line) - offset, " %u/%u %lldms",
+					   src->rx[phase], phase_msg_count(phase),
+					   src->rx[phase] ? src->lat_sum[phase] / src->rx[phase] : 0);
+		}
+
+		LOG_INF("%s", line);
+	}
+
+	if (saturated >= 0) {
+		LOG_INF("Sink neighbours delivery fell below %d%% in phase %d (period %d ms per "
+			"source)", cc_sat_pct, saturated, cc_periods[saturated]);
+	} else {
+		LOG_INF("Sink neighbours delivery stayed above %d%% in all phases", cc_sat_pct);
+	}
+}
+
+int bt_mesh_tst_cc_wait_time(void)
+{
+	return WAIT_TIME;
+}
+
+static void test_cc_node_sink_init(void)
+{
+	bt_mesh_test_cfg_set(WAIT_TIME);
+}
+
+static void test_cc_node_sink(void)
+{
+	/* Note: Sink device is instantiated at last in test script, and hence this is also
+	 * equal to total number of devices in the network.
+	 */
+	int total_nodes = bsim_args_get_global_device_nbr() + 1;
+
+	ASSERT_TRUE_MSG(total_nodes <= MAX_DEVICES, "Edit MAX_DEVICES and recompile");
+	ASSERT_TRUE_MSG(cc_sink == total_nodes - 1, "Sink index %d is not the last device",
+			cc_sink);
+
+	bt_mesh_device_setup(&prov, &comp);
+	dev_prov_and_conf(total_nodes);
+	bt_mesh_tst_prof_phase("measurement");
+
+	sleep_until(CC_START_MS + (int64_t)cc_phase_count * cc_phase_ms + CC_DRAIN_MS);
+
+	cc_print_results(total_nodes);
+
+	PASS();
+
+	bs_trace_silent_exit(0);
+}
+
+static void test_terminate(void)
+{
+	bt_mesh_tst_prof_report();
+	bt_mesh_tst_links_report();
+	bt_mesh_tst_cache_report();
+}
+
+#define TEST_CASE(role, name, description)                       \
+	{                                                        \
+		.test_id = #role "_" #name,                      \
+		.test_descr = description,                       \
+		.test_tick_f = bt_mesh_test_timeout,             \
+		.test_args_f = bt_mesh_tst_args_parse,          \
+		.test_post_init_f = test_##role##_##name##_init, \
+		.test_main_f = test_##role##_##name,             \
+		.test_delete_f = test_terminate,                 \
+	}
+
+static const struct bst_test_instance test_cc[] = {
+	TEST_CASE(cc_node, device, "Source periodically reporting to the sink"),
+	TEST_CASE(cc_node, sink, "Sink (gateway) collecting reports from all sources"),
+	BSTEST_END_MARKER
+};
+
+struct bst_test_list *test_cc_install(struct bst_test_list *tests)
+{
+	tests = bst_add_tests(tests, test_cc);
+	return tests;
+}
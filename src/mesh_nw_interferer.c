@@ -0,0 +1,221 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "mesh_test.h"
+
+#include <zephyr/kernel.h>
+#include <zephyr/bluetooth/bluetooth.h>
+#include "bs_tracing.h"
+#include "bs_utils.h"
+#include "bsim_args_runner.h"
+
+#define LOG_MODULE_NAME mesh_nw_intf
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(LOG_MODULE_NAME);
+
+extern int max_iterations;
+extern char *intf_mode;
+extern int intf_interval_ms;
+extern int intf_period_ms;
+extern int intf_duty;
+extern int intf_len;
+extern int burst_size_count;
+extern int proxy_node;
+
+/* Interferers run for as long as the mesh devices of their scenario do, see the WAIT_TIME of
+ * mesh_nw_test.c and mesh_nw_test_vnd_mdl.c. Convergecast nodes give theirs with
+ * bt_mesh_tst_cc_wait_time().
+ */
+#define WAIT_TIME (max_iterations * MAX_DEVICES * 2 * MAX(burst_size_count, 1) * \
+		   (proxy_node >= 0 ? 2 : 1))
+#define VND_WAIT_TIME (max_iterations * MAX_DEVICES * 6)
+
+/* Largest payload of a legacy advertising PDU */
+#define LEGACY_ADV_DATA_MAX (31)
+
+/* Largest payload put in a single extended advertising PDU by this interferer */
+#define EXT_ADV_DATA_MAX (191)
+
+extern enum bst_result_t bst_result;
+
+enum intf_role {
+	INTF_ADV_LEGACY,
+	INTF_ADV_EXT,
+	INTF_SCAN,
+};
+
+static struct bt_le_ext_adv *adv;
+static uint8_t mfg_data[EXT_ADV_DATA_MAX];
+static struct bt_data ad;
+
+static enum intf_role role_get(void)
+{
+	if (!intf_mode || !strcmp(intf_mode, "adv_legacy")) {
+		return INTF_ADV_LEGACY;
+	} else if (!strcmp(intf_mode, "adv_ext")) {
+		return INTF_ADV_EXT;
+	} else if (!strcmp(intf_mode, "scan")) {
+		return INTF_SCAN;
+	}
+
+	FAIL("Unknown interferer mode %s", intf_mode);
+	return INTF_ADV_LEGACY;
+}
+
+static void adv_setup(enum intf_role role)
+{
+	struct bt_le_adv_param param = BT_LE_ADV_PARAM_INIT(
+		role == INTF_ADV_EXT ? BT_LE_ADV_OPT_EXT_ADV : BT_LE_ADV_OPT_NONE,
+		intf_interval_ms * 8 / 5, intf_interval_ms * 8 / 5, NULL);
+	size_t max_len = role == INTF_ADV_EXT ? EXT_ADV_DATA_MAX : LEGACY_ADV_DATA_MAX;
+	int err;
+
+	/* Manufacturer specific data, so mesh nodes parse and drop these as non-mesh adverts */
+	ad.type = BT_DATA_MANUFACTURER_DATA;
+	ad.data_len = CLAMP(intf_len, 2, max_len - 2);
+	ad.data = mfg_data;
+	mfg_data[0] = CONFIG_BT_COMPANY_ID & 0xff;
+	mfg_data[1] = CONFIG_BT_COMPANY_ID >> 8;
+	memset(&mfg_data[2], bsim_args_get_global_device_nbr(), ad.data_len - 2);
+
+	err = bt_le_ext_adv_create(&param, NULL, &adv);
+	if (err) {
+		FAIL("Failed to create advertising set (err %d)", err);
+		return;
+	}
+
+	err = bt_le_ext_adv_set_data(adv, &ad, 1, NULL, 0);
+	if (err) {
+		FAIL("Failed to set advertising data (err %d)", err);
+	}
+}
+
+static int intf_on(enum intf_role role)
+{
+	if (role == INTF_SCAN) {
+		struct bt_le_scan_param param = BT_LE_SCAN_PARAM_INIT(
+			BT_LE_SCAN_TYPE_ACTIVE, BT_LE_SCAN_OPT_NONE,
+			intf_interval_ms * 8 / 5, intf_interval_ms * 8 / 5);
+
+		return bt_le_scan_start(&param, NULL);
+	}
+
+	return bt_le_ext_adv_start(adv, BT_LE_EXT_ADV_START_DEFAULT);
+}
+
+static int intf_off(enum intf_role role)
+{
+	if (role == INTF_SCAN) {
+		return bt_le_scan_stop();
+	}
+
+	return bt_le_ext_adv_stop(adv);
+}
+
+static void test_node_interferer_init(void)
+{
+	bt_mesh_test_cfg_set(WAIT_TIME);
+}
+
+static void test_vnd_node_interferer_init(void)
+{
+	bt_mesh_test_cfg_set(VND_WAIT_TIME);
+}
+
+static void test_cc_node_interferer_init(void)
+{
+	bt_mesh_test_cfg_set(bt_mesh_tst_cc_wait_time());
+}
+
+static void test_node_interferer(void)
+{
+	enum intf_role role = role_get();
+	int on_ms = intf_period_ms * intf_duty / 100;
+	int64_t on_total = 0;
+	int err;
+
+	bt_mesh_tst_prof_phase("setup");
+
+	err = bt_enable(NULL);
+	if (err) {
+		FAIL("Bluetooth init failed (err %d)", err);
+		return;
+	}
+
+	LOG_INF("Interferer %d: mode %s interval %d ms duty %d%% of %d ms len %d",
+		bsim_args_get_global_device_nbr(), intf_mode ? intf_mode : "adv_legacy",
+		intf_interval_ms, intf_duty, intf_period_ms, intf_len);
+
+	if (role != INTF_SCAN) {
+		adv_setup(role);
+	}
+
+	bt_mesh_tst_prof_phase("measurement");
+
+	/* Interferers have nothing to verify, the run is judged by the mesh tester */
+	PASS();
+
+	if (intf_duty >= 100) {
+		err = intf_on(role);
+		if (err) {
+			FAIL("Failed to start interferer (err %d)", err);
+		}
+
+		return;
+	}
+
+	while (on_ms > 0) {
+		err = intf_on(role);
+		if (err) {
+			LOG_ERR("Failed to start interferer (err %d)", err);
+		}
+
+		k_sleep(K_MSEC(on_ms));
+		on_total += on_ms;
+
+		err = intf_off(role);
+		if (err) {
+			LOG_ERR("Failed to stop interferer (err %d)", err);
+		}
+
+		k_sleep(K_MSEC(intf_period_ms - on_ms));
+
+		LOG_DBG("Interferer active for %lld ms so far", on_total);
+	}
+}
+
+static void test_vnd_node_interferer(void)
+{
+	test_node_interferer();
+}
+
+static void test_cc_node_interferer(void)
+{
+	test_node_interferer();
+}
+
+#define TEST_CASE(role, name, description)                       \
+	{                                                        \
+		.test_id = #role "_" #name,                      \
+		.test_descr = description,                       \
+		.test_tick_f = bt_mesh_test_timeout,             \
+		.test_args_f = bt_mesh_tst_args_parse,          \
+		.test_post_init_f = test_##role##_##name##_init, \
+		.test_main_f = test_##role##_##name,             \
+		.test_delete_f = bt_mesh_tst_prof_report,        \
+	}
+
+static const struct bst_test_instance test_intf[] = {
+	TEST_CASE(node, interferer, "Non-mesh BLE advertiser or scanner"),
+	TEST_CASE(vnd_node, interferer, "Non-mesh BLE advertiser or scanner, vendor model run"),
+	TEST_CASE(cc_node, interferer, "Non-mesh BLE advertiser or scanner, convergecast run"),
+	BSTEST_END_MARKER
+};
+
+struct bst_test_list *test_intf_install(struct bst_test_list *tests)
+{
+	tests = bst_add_tests(tests, test_intf);
+	return tests;
+}
@@ -6,21 +6,44 @@
 #include "mesh_test.h"
 
 #include <zephyr/kernel.h>
+#include <zephyr/bluetooth/conn.h>
+#include <zephyr/bluetooth/mesh/proxy.h>
 #include "bs_tracing.h"
 #include "bs_utils.h"
 #include "bsim_args_runner.h"
 
+#include "mesh/net.h"
+#include "mesh/access.h"
 
 #define LOG_MODULE_NAME mesh_nw_test
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(LOG_MODULE_NAME);
 
 extern int max_iterations;
+extern int run_seed;
+extern int quiet_ms;
+extern int quiet_max_ms;
+extern int proxy_node;
+extern int proxy_conn_int_ms;
 extern int dut_list[MAX_DEVICES];
 extern int dut_count;
 extern int net_id_counts;
+extern int burst_sizes[BURST_MAX_PHASES];
+extern int burst_size_count;
+extern char *burst_mode;
 
-#define WAIT_TIME (max_iterations * MAX_DEVICES * 2)
+/* Every burst size is one more measurement phase */
+#define WAIT_TIME (max_iterations * MAX_DEVICES * 2 * MAX(burst_size_count, 1))
+
+/* Group the Health Servers of the DUTs subscribe to in the group burst mode */
+#define BURST_GROUP_ADDR (0xc100)
+
+/* Longest wait for the responses of one burst */
+#define BURST_TIMEOUT_MS (10000)
+
+/* Response latency histogram resolution and range, used for the per-size percentiles */
+#define BURST_HIST_BIN_MS (10)
+#define BURST_HIST_BINS (BURST_TIMEOUT_MS / BURST_HIST_BIN_MS)
 
 extern enum bst_result_t bst_result;
 
@@ -39,9 +62,49 @@ static struct bt_mesh_model_pub health_pub = {
 	.msg = NET_BUF_SIMPLE(BT_MESH_TX_SDU_MAX),
 };
 
+enum burst_target {
+	BURST_TARGET_DUT,
+	BURST_TARGET_MULTI,
+	BURST_TARGET_GROUP,
+};
+
+/* Burst in progress, responses are matched to it by count only */
+static struct {
+	atomic_t active;
+	int64_t start_ms;
+	int64_t last_ms;
+	int expected;
+	int received;
+	uint32_t *hist;
+} burst;
+
+static K_SEM_DEFINE(burst_done_sem, 0, 1);
+
+static void burst_rsp(void)
+{
+	int64_t latency;
+
+	if (!atomic_get(&burst.active) || burst.received >= burst.expected) {
+		return;
+	}
+
+	burst.last_ms = k_uptime_get();
+	latency = burst.last_ms - burst.start_ms;
+	burst.hist[MIN(latency / BURST_HIST_BIN_MS, BURST_HIST_BINS - 1)]++;
+
+	if (++burst.received == burst.expected) {
+		k_sem_give(&burst_done_sem);
+	}
+}
+
 static void health_attention_status(struct bt_mesh_health_cli *cli,
 				    uint16_t addr, uint8_t attention)
 {
+	if (atomic_get(&burst.active)) {
+		burst_rsp();
+		return;
+	}
+
 	LOG_INF("Health Attention Status from 0x%04x: %u", addr, attention);
 }
 
@@ -71,23 +134,40 @@ static void additional_configure(uint16_t addr)
 	uint8_t status;
 	int err;
 
-	/* Bind AppKey to Health Server and Client */
-	err = bt_mesh_cfg_cli_mod_app_bind(net_idx, addr, addr, app_idx,
-					   BT_MESH_MODEL_ID_HEALTH_SRV, &status);
-	if (err || status) {
-		FAIL("Model 0x%04x bind failed (err %d, status %u)", BT_MESH_MODEL_ID_HEALTH_SRV, err,
-		     status);
-		return;
-	}
+	/* Bind the AppKey of every zone the node is in to Health Server and Client. Without a
+	 * zone map, this is only app_idx.
+	 */
+	for (int idx = 0; idx < CONFIG_BT_MESH_SUBNET_COUNT; idx++) {
+		if (!bt_mesh_tst_zone_member(addr - 1, idx)) {
+			continue;
+		}
 
-	err = bt_mesh_cfg_cli_mod_app_bind(net_idx, addr, addr, app_idx,
-					   BT_MESH_MODEL_ID_HEALTH_CLI, &status);
-	if (err || status) {
-		FAIL("Model 0x%04x bind failed (err %d, status %u)", BT_MESH_MODEL_ID_HEALTH_SRV, err,
-		     status);
-		return;
+		err = bt_mesh_cfg_cli_mod_app_bind(net_idx, addr, addr, idx,
+						   BT_MESH_MODEL_ID_HEALTH_SRV, &status);
+		if (err || status) {
+			FAIL("Model 0x%04x bind failed (err %d, status %u)",
+			     BT_MESH_MODEL_ID_HEALTH_SRV, err, status);
+			return;
+		}
+
+		err = bt_mesh_cfg_cli_mod_app_bind(net_idx, addr, addr, idx,
+						   BT_MESH_MODEL_ID_HEALTH_CLI, &status);
+		if (err || status) {
+			FAIL("Model 0x%04x bind failed (err %d, status %u)",
+			     BT_MESH_MODEL_ID_HEALTH_CLI, err, status);
+			return;
+		}
 	}
 
+	/* DUTs answer the group bursts of the burst tester */
+	if (burst_mode && !strcmp(burst_mode, "group") && is_dut(addr - 1, dut_list, dut_count)) {
+		err = bt_mesh_cfg_cli_mod_sub_add(net_idx, addr, addr, BURST_GROUP_ADDR,
+						  BT_MESH_MODEL_ID_HEALTH_SRV, &status);
+		if (err || status) {
+			FAIL("Group 0x%04x subscription failed (err %d, status %u)",
+			     BURST_GROUP_ADDR, err, status);
+		}
+	}
 }
 
 static void dev_prov_and_conf(uint16_t addr)
@@ -98,66 +178,216 @@ static void dev_prov_and_conf(uint16_t addr)
 	additional_configure(addr);
 }
 
-static void test_node_device_init(void)
+/* Only the selected proxy node keeps the GATT Proxy feature, so the proxy client is guaranteed
+ * to connect to it.
+ */
+static void gatt_proxy_disable(uint16_t addr)
 {
-	bt_mesh_test_cfg_set(WAIT_TIME);
+	uint8_t status;
+	int err;
+
+	err = bt_mesh_cfg_cli_gatt_proxy_set(net_idx, addr, BT_MESH_GATT_PROXY_DISABLED, &status);
+	if (err || status != BT_MESH_GATT_PROXY_DISABLED) {
+		FAIL("GATT Proxy disable failed (err %d, status %u)", err, status);
+	}
 }
 
-static void test_node_device(void)
+/* Proxy client connection (tester) and proxy load accounting (serving node) */
+static struct bt_conn *proxy_conn;
+static K_SEM_DEFINE(proxy_conn_sem, 0, 1);
+static K_SEM_DEFINE(proxy_param_sem, 0, 1);
+static struct bt_mesh_statistic proxy_stat_start;
+static int64_t proxy_conn_start;
+static int64_t proxy_conn_time;
+static int proxy_conn_cnt;
+
+/* While the GATT bearer is measured, the tester drops the network PDUs that reach it over the
+ * advertising bearer, so every response it gets came through the proxy connection.
+ * bt_mesh_net_recv() is wrapped at link time (see CMakeLists.txt).
+ */
+static bool adv_rx_blocked;
+static uint32_t adv_rx_dropped;
+
+void __real_bt_mesh_net_recv(struct net_buf_simple *data, int8_t rssi,
+			     enum bt_mesh_net_if net_if);
+
+void __wrap_bt_mesh_net_recv(struct net_buf_simple *data, int8_t rssi,
+			     enum bt_mesh_net_if net_if)
 {
-	bst_result = In_progress;
-	LOG_INF("Hello :simid %s nbr %d", bsim_args_get_simid(), bsim_args_get_global_device_nbr());
+	if (adv_rx_blocked && net_if == BT_MESH_NET_IF_ADV) {
+		adv_rx_dropped++;
+		return;
+	}
 
-	bt_mesh_device_setup(&prov, &comp);
-	dev_prov_and_conf(bsim_args_get_global_device_nbr() + 1);
+	__real_bt_mesh_net_recv(data, rssi, net_if);
+}
 
-	PASS();
+/* The Health Client does not pass the receive TTL on, so the tester takes it from the access
+ * layer for the DUT it probes. bt_mesh_access_recv() is wrapped at link time (see CMakeLists.txt).
+ */
+static uint16_t probe_addr;
+static uint8_t probe_recv_ttl;
+
+int __real_bt_mesh_access_recv(struct bt_mesh_msg_ctx *ctx, struct net_buf_simple *buf);
+
+int __wrap_bt_mesh_access_recv(struct bt_mesh_msg_ctx *ctx, struct net_buf_simple *buf)
+{
+	if (probe_addr && ctx->addr == probe_addr) {
+		probe_recv_ttl = ctx->recv_ttl;
+	}
+
+	return __real_bt_mesh_access_recv(ctx, buf);
 }
 
-/* Parse command line arguments */
-static void test_args_parse(int argc, char *argv[])
-{
-	static char *duts_str;
-
-	bs_args_struct_t args_struct[] = {
-		{
-			.dest = &max_iterations,
-			.type = 'i',
-			.name = "{integer}",
-			.option = "iterations",
-			.descript = "Number of iterations to run for each test"
-		},
-		{
-			.dest = &duts_str,
-			.type = 's',
-			.name = "{string}",
-			.option = "duts",
-			.descript = "Comma-separated list of DUT indices to test"
-		},
-		ARG_TABLE_ENDMARKER
-	};
+static void connected(struct bt_conn *conn, uint8_t conn_err)
+{
+	struct bt_conn_info info;
 
-	bs_args_parse_all_cmd_line(argc, argv, args_struct);
+	if (conn_err || bt_conn_get_info(conn, &info)) {
+		return;
+	}
 
-	if (max_iterations < 1 || max_iterations > MAX_ITERATIONS) {
-		FAIL("Invalid number of given iterations %d. Max allowed %d", max_iterations,
-		     MAX_ITERATIONS);
+	LOG_INF("Proxy %s connected, interval %u (x1.25 ms)",
+		info.role == BT_CONN_ROLE_CENTRAL ? "server" : "client", info.le.interval);
+
+	if (info.role == BT_CONN_ROLE_CENTRAL) {
+		proxy_conn = bt_conn_ref(conn);
+		k_sem_give(&proxy_conn_sem);
+	} else {
+		/* Count the load from the moment a proxy client is attached */
+		bt_mesh_stat_get(&proxy_stat_start);
+		proxy_conn_start = k_uptime_get();
+		proxy_conn_cnt++;
 	}
+}
 
-	dut_count = ARRAY_SIZE(dut_list);
-	parse_dut_list(duts_str, dut_list, &dut_count);
+static void disconnected(struct bt_conn *conn, uint8_t reason)
+{
+	LOG_INF("Proxy connection lost (reason 0x%02x)", reason);
+
+	if (conn == proxy_conn) {
+		bt_conn_unref(proxy_conn);
+		proxy_conn = NULL;
+	} else if (proxy_conn_start) {
+		proxy_conn_time += k_uptime_get() - proxy_conn_start;
+		proxy_conn_start = 0;
+	}
 }
 
-static void test_node_tester_init(void)
+static void le_param_updated(struct bt_conn *conn, uint16_t interval, uint16_t latency,
+			     uint16_t timeout)
 {
-	bt_mesh_test_cfg_set(WAIT_TIME);
+	LOG_INF("Proxy connection interval %u (x1.25 ms) latency %u", interval, latency);
+
+	if (conn == proxy_conn) {
+		k_sem_give(&proxy_param_sem);
+	}
 }
 
-static void test_node_tester(void)
+BT_CONN_CB_DEFINE(conn_callbacks) = {
+	.connected = connected,
+	.disconnected = disconnected,
+	.le_param_updated = le_param_updated,
+};
+
+static void proxy_load_report(void)
 {
+	struct bt_mesh_statistic st;
+	int64_t conn_time = proxy_conn_time;
+	uint32_t rx_proxy, relayed;
+
+	if (!proxy_conn_cnt) {
+		return;
+	}
+
+	if (proxy_conn_start) {
+		conn_time += k_uptime_get() - proxy_conn_start;
+	}
+
+	bt_mesh_stat_get(&st);
+	rx_proxy = st.rx_proxy - proxy_stat_start.rx_proxy;
+	relayed = st.tx_adv_relay_planned - proxy_stat_start.tx_adv_relay_planned;
+	conn_time = MAX(conn_time, 1);
+
+	LOG_INF("Proxy load: %d connection(s), %lld ms connected, %u PDUs from client "
+		"(%lld/min), %u PDUs relayed to ADV (%lld/min), %u ADV PDUs received",
+		proxy_conn_cnt, conn_time, rx_proxy, rx_proxy * 60000LL / conn_time, relayed,
+		relayed * 60000LL / conn_time, st.rx_adv - proxy_stat_start.rx_adv);
+}
+
+static int proxy_client_connect(void)
+{
+	struct bt_conn_info info;
 	int err;
-	int64_t t1, t2;
 
+	err = bt_mesh_proxy_connect(net_idx);
+	if (err) {
+		LOG_ERR("Proxy connect failed (err %d)", err);
+		return err;
+	}
+
+	err = k_sem_take(&proxy_conn_sem, K_SECONDS(60));
+	if (err) {
+		LOG_ERR("No connection to proxy node %d", proxy_node);
+		return err;
+	}
+
+	if (proxy_conn_int_ms) {
+		struct bt_le_conn_param param = BT_LE_CONN_PARAM_INIT(
+			proxy_conn_int_ms * 4 / 5, proxy_conn_int_ms * 4 / 5, 0, 400);
+
+		err = bt_conn_le_param_update(proxy_conn, &param);
+		if (!err) {
+			err = k_sem_take(&proxy_param_sem, K_SECONDS(10));
+		}
+
+		if (err) {
+			LOG_WRN("Connection interval update failed (err %d)", err);
+		}
+	}
+
+	/* Let service discovery and notification subscription of the proxy client finish */
+	k_sleep(K_SECONDS(2));
+	bt_mesh_tst_wait_quiet();
+
+	err = bt_conn_get_info(proxy_conn, &info);
+	if (err) {
+		return err;
+	}
+
+	proxy_conn_int_ms = info.le.interval * 5 / 4;
+	LOG_INF("Proxy client ready, connection interval %d ms", proxy_conn_int_ms);
+
+	return 0;
+}
+
+static void test_node_device_init(void)
+{
+	/* The proxy tester measures both bearers, the devices must last as long */
+	bt_mesh_test_cfg_set(proxy_node >= 0 ? WAIT_TIME * 2 : WAIT_TIME);
+}
+
+static void test_node_device(void)
+{
+	bst_result = In_progress;
+	LOG_INF("Hello :simid %s nbr %d", bsim_args_get_simid(), bsim_args_get_global_device_nbr());
+
+	bt_mesh_device_setup(&prov, &comp);
+	dev_prov_and_conf(bsim_args_get_global_device_nbr() + 1);
+
+	if (proxy_node >= 0 && proxy_node != bsim_args_get_global_device_nbr()) {
+		gatt_proxy_disable(bsim_args_get_global_device_nbr() + 1);
+	}
+
+	bt_mesh_tst_hb_discovery(bsim_args_get_global_device_nbr() + 1, false);
+	bt_mesh_tst_prof_phase("measurement");
+
+	PASS();
+}
+
+/* Provision and configure the tester. Returns the total number of nodes in the network. */
+static int tester_setup(void)
+{
 	/* Note: Tester device is instantiated at last in test script, and hence this is also
 	 * equal to total number of devices in the network.
 	 */
@@ -176,6 +406,10 @@ static void test_node_tester(void)
 	dev_prov_and_conf(tester_addr);
 
 	LOG_INF("Using MAX_ITERATIONS: %d", max_iterations);
+	if (run_seed >= 0) {
+		LOG_INF("Run seed: %d", run_seed);
+	}
+	LOG_INF("Inter-probe quiet window: %d ms (max %d ms)", quiet_ms, quiet_max_ms);
 
 	/* Print DUT list if specified */
 	if (dut_count > 0) {
@@ -185,6 +419,25 @@ static void test_node_tester(void)
 		}
 	}
 
+	bt_mesh_tst_hb_discovery(tester_addr, true);
+	bt_mesh_tst_prof_phase("measurement");
+
+	return total_nodes;
+}
+
+/* Measure round-trip latency to every DUT and store it in res */
+static void latency_run(struct test_results *res, int total_nodes, uint16_t tester_addr)
+{
+	int err;
+	int64_t t1, t2;
+	int duts = 0;
+
+	for (int dut = 0; dut < total_nodes; dut++) {
+		duts += is_dut(dut, dut_list, dut_count);
+	}
+
+	bt_mesh_tst_metrics_plan(duts);
+
 	for(int dut = 0; dut < total_nodes; dut++)
 	{
 		/* Skip if not in DUT list */
@@ -194,9 +447,9 @@ static void test_node_tester(void)
 
 		int dut_addr = dut + 1;
 
-		tst_res[dut].d_id = dut;
-		tst_res[dut].addr = dut_addr;
-		tst_res[dut].failures = 0;
+		res[dut].d_id = dut;
+		res[dut].addr = dut_addr;
+		res[dut].failures = 0;
 
 		LOG_INF("Testing latency for Dev: 0x%04x (ID: %d) Tester: 0x%04x", dut_addr,
 			 dut, tester_addr);
@@ -206,34 +459,376 @@ static void test_node_tester(void)
 			struct bt_mesh_msg_ctx ctx = {0};
 			uint8_t attention;
 
-			ctx.net_idx = net_idx;
-			ctx.app_idx = app_idx;
+			/* The DUT's own subnet, the tester is in all zones */
+			ctx.net_idx = bt_mesh_tst_zone_net_idx(dut);
+			ctx.app_idx = ctx.net_idx;
 			ctx.addr = dut_addr;
 			ctx.send_ttl = MAX_TTL;
 			ctx.send_rel = 0;
 
+			/* The tester answers itself over the local interface, no hops to record */
+			probe_addr = dut_addr != tester_addr ? dut_addr : BT_MESH_ADDR_UNASSIGNED;
+			probe_recv_ttl = 0;
+
 			t1 = k_uptime_get();
 			err = bt_mesh_health_cli_attention_get(&health_cli, &ctx, &attention);
 
 			if (err) {
 				LOG_ERR("Health Attention Get failed (err %d)", err);
-				tst_res[dut].failures++;
-				k_sleep(K_MSEC(200));
+				res[dut].failures++;
+				bt_mesh_tst_metrics_probe(0, false);
+				bt_mesh_tst_wait_quiet();
 				continue;
 			}
 
 			t2 = k_uptime_get();
-			tst_res[dut].latency[i] = t2 - t1;
+			res[dut].latency[i] = t2 - t1;
+			res[dut].ttl[i] = probe_recv_ttl;
 
-			LOG_INF("Latency: %d", tst_res[dut].latency[i]);
+			LOG_INF("Latency: %d", res[dut].latency[i]);
+			bt_mesh_tst_metrics_probe(res[dut].latency[i], true);
 
-			k_sleep(K_MSEC(1200));
+			bt_mesh_tst_wait_quiet();
 		}
 
 		LOG_INF("Network ID advertisements count %d", net_id_counts);
+		bt_mesh_tst_metrics_dut_done();
+	}
+
+	probe_addr = BT_MESH_ADDR_UNASSIGNED;
+}
+
+static void test_node_tester_init(void)
+{
+	bt_mesh_test_cfg_set(WAIT_TIME);
+}
+
+static void test_node_tester(void)
+{
+	int total_nodes = tester_setup();
+
+	latency_run(tst_res, total_nodes, total_nodes);
+	bt_mesh_tst_metrics_finish();
+
+	print_common_results(total_nodes, max_iterations);
+	bt_mesh_tst_zone_results(tst_res, total_nodes, max_iterations);
+
+	PASS();
+
+	bs_trace_silent_exit(0);
+}
+
+/* Latency results over the GATT proxy bearer */
+static struct test_results gatt_res[MAX_DEVICES];
+
+/* Summarize one bearer: successful exchanges, the time they were in flight, and their rate over
+ * the whole phase, quiet windows included
+ */
+static void bearer_summary(const char *name, const struct test_results *res, int total_nodes,
+			   int64_t phase_ms)
+{
+	int64_t busy_ms = 0;
+	int ok = 0;
+
+	for (int dut = 0; dut < total_nodes; dut++) {
+		if (!is_dut(dut, dut_list, dut_count)) {
+			continue;
+		}
+
+		for (int i = 0; i < max_iterations; i++) {
+			busy_ms += res[dut].latency[i];
+		}
+
+		ok += max_iterations - res[dut].failures;
 	}
 
+	LOG_INF("%s bearer: %d exchanges in %lld ms, %lld ms in flight, %lld.%02lld exchanges/s",
+		name, ok, phase_ms, busy_ms, ok * 1000LL / MAX(phase_ms, 1),
+		(ok * 100000LL / MAX(phase_ms, 1)) % 100);
+}
+
+/* Percentile over the answered probes only, failed ones leave their latency at 0 */
+static int64_t answered_percentile(const struct test_results *res, int pct)
+{
+	int64_t answered[MAX_ITERATIONS];
+	int n = 0;
+
+	for (int i = 0; i < max_iterations; i++) {
+		if (res->latency[i] > 0) {
+			answered[n++] = res->latency[i];
+		}
+	}
+
+	return bt_mesh_tst_percentile(answered, n, pct);
+}
+
+static void bearer_comparison(int total_nodes, int64_t adv_ms, int64_t gatt_ms)
+{
+	LOG_INF("ADV vs GATT proxy (node %d, connection interval %d ms) round-trip latency:",
+		proxy_node, proxy_conn_int_ms);
+
+	for (int dut = 0; dut < total_nodes; dut++) {
+		if (!is_dut(dut, dut_list, dut_count)) {
+			continue;
+		}
+
+		LOG_INF("Bearers dev %d addr 0x%04x: adv p50 %lld p95 %lld fail %d | "
+			"gatt p50 %lld p95 %lld fail %d", dut, dut + 1,
+			answered_percentile(&tst_res[dut], 50),
+			answered_percentile(&tst_res[dut], 95),
+			tst_res[dut].failures,
+			answered_percentile(&gatt_res[dut], 50),
+			answered_percentile(&gatt_res[dut], 95),
+			gatt_res[dut].failures);
+	}
+
+	bearer_summary("ADV", tst_res, total_nodes, adv_ms);
+	bearer_summary("GATT", gatt_res, total_nodes, gatt_ms);
+}
+
+static void test_node_proxy_tester_init(void)
+{
+	/* Both bearers are measured in one run */
+	bt_mesh_test_cfg_set(WAIT_TIME * 2);
+}
+
+static void test_node_proxy_tester(void)
+{
+	int total_nodes = tester_setup();
+	int64_t adv_ms, gatt_ms;
+	int err;
+
+	if (proxy_node < 0 || proxy_node >= total_nodes - 1) {
+		FAIL("Invalid proxy node %d", proxy_node);
+		return;
+	}
+
+	gatt_proxy_disable(total_nodes);
+
+	/* Phase 1: reference over the advertising bearer */
+	LOG_INF("Measuring over ADV bearer");
+	adv_ms = k_uptime_get();
+	latency_run(tst_res, total_nodes, total_nodes);
+	adv_ms = k_uptime_get() - adv_ms;
+
+	/* Phase 2: the same probes entering the mesh through the proxy node. With a proxy
+	 * connection up, unicast messages are sent on the GATT bearer only.
+	 */
+	err = proxy_client_connect();
+	if (err) {
+		FAIL("Proxy client setup failed (err %d)", err);
+		return;
+	}
+
+	/* A response could otherwise reach the tester over ADV before the proxy notification */
+	adv_rx_blocked = true;
+	LOG_INF("Measuring over GATT proxy bearer through Dev %d, ADV reception disabled on the "
+		"tester", proxy_node);
+	gatt_ms = k_uptime_get();
+	latency_run(gatt_res, total_nodes, total_nodes);
+	gatt_ms = k_uptime_get() - gatt_ms;
+	adv_rx_blocked = false;
+	LOG_INF("GATT phase: %u PDUs received over ADV were dropped", adv_rx_dropped);
+	bt_mesh_tst_metrics_finish();
+
 	print_common_results(total_nodes, max_iterations);
+	bearer_comparison(total_nodes, adv_ms, gatt_ms);
+
+	PASS();
+
+	bs_trace_silent_exit(0);
+}
+
+/* Results of one burst size */
+struct burst_stats {
+	int bursts;
+	int sent;
+	int send_err;
+	int expected;
+	int received;
+	int complete;
+	int64_t block_ms;
+	int64_t complete_ms;
+	uint32_t hist[BURST_HIST_BINS];
+};
+
+static enum burst_target burst_target_get(void)
+{
+	if (!burst_mode || !strcmp(burst_mode, "dut")) {
+		return BURST_TARGET_DUT;
+	} else if (!strcmp(burst_mode, "multi")) {
+		return BURST_TARGET_MULTI;
+	} else if (!strcmp(burst_mode, "group")) {
+		return BURST_TARGET_GROUP;
+	}
+
+	FAIL("Unknown burst mode %s", burst_mode);
+	return BURST_TARGET_DUT;
+}
+
+static uint32_t burst_percentile(const struct burst_stats *st, int pct)
+{
+	return bt_mesh_tst_hist_percentile(st->hist, BURST_HIST_BINS, BURST_HIST_BIN_MS,
+					   st->received, pct);
+}
+
+/* Send k Attention Gets back-to-back, the j-th one to dst[j], and wait for rsp_per_req
+ * responses to each. The send calls block while the local advertising pool is exhausted.
+ */
+static void burst_run(const uint16_t *dst, int k, int rsp_per_req, struct burst_stats *st)
+{
+	struct bt_mesh_msg_ctx ctx = {
+		.net_idx = net_idx,
+		.app_idx = app_idx,
+		.send_ttl = MAX_TTL,
+	};
+	int64_t t;
+	int err;
+
+	k_sem_reset(&burst_done_sem);
+	burst.hist = st->hist;
+	burst.expected = k * rsp_per_req;
+	burst.received = 0;
+	burst.start_ms = k_uptime_get();
+	atomic_set(&burst.active, 1);
+
+	for (int j = 0; j < k; j++) {
+		ctx.addr = dst[j];
+		t = k_uptime_get();
+		err = bt_mesh_health_cli_attention_get(&health_cli, &ctx, NULL);
+		st->block_ms += k_uptime_get() - t;
+
+		if (err) {
+			LOG_ERR("Burst request %d of %d to 0x%04x failed (err %d)", j + 1, k, dst[j],
+				err);
+			st->send_err++;
+			burst.expected -= rsp_per_req;
+			continue;
+		}
+
+		st->sent++;
+	}
+
+	if (burst.received < burst.expected) {
+		k_sem_take(&burst_done_sem, K_MSEC(BURST_TIMEOUT_MS));
+	}
+
+	atomic_set(&burst.active, 0);
+
+	st->bursts++;
+	st->expected += burst.expected;
+	st->received += burst.received;
+
+	if (burst.expected && burst.received == burst.expected) {
+		st->complete++;
+		st->complete_ms += burst.last_ms - burst.start_ms;
+	}
+
+	bt_mesh_tst_wait_quiet();
+}
+
+static void burst_report(int k, const struct burst_stats *st, uint32_t base_p50)
+{
+	uint32_t p50 = burst_percentile(st, 50);
+
+	LOG_INF("Burst size %d: %d bursts, %d sent, %d send errors, %d/%d responses, "
+		"p50 %u ms p95 %u ms, queueing %+d ms vs size %d, complete in %lld ms, "
+		"send blocked %lld ms/burst", k, st->bursts, st->sent, st->send_err, st->received,
+		st->expected, p50, burst_percentile(st, 95), (int)p50 - (int)base_p50,
+		burst_sizes[0], st->complete ? st->complete_ms / st->complete : -1LL,
+		st->block_ms / MAX(st->bursts, 1));
+}
+
+static void test_node_burst_tester_init(void)
+{
+	bt_mesh_test_cfg_set(WAIT_TIME);
+}
+
+static void test_node_burst_tester(void)
+{
+	static struct burst_stats stats[BURST_MAX_PHASES];
+	enum burst_target target = burst_target_get();
+	int total_nodes = tester_setup();
+	uint16_t tester_addr = total_nodes;
+	uint16_t duts[MAX_DEVICES];
+	uint16_t dst[BURST_MAX_LEN];
+	uint32_t base_p50 = 0;
+	int dut_n = 0;
+	int next = 0;
+	uint8_t status;
+	int err;
+
+	/* The tester itself is never a DUT here */
+	for (int dut = 0; dut < total_nodes - 1; dut++) {
+		if (is_dut(dut, dut_list, dut_count)) {
+			duts[dut_n++] = dut + 1;
+		}
+	}
+
+	if (!burst_size_count || !dut_n) {
+		FAIL("Burst sizes (burst_sizes) and at least one DUT are required");
+		return;
+	}
+
+	if (target == BURST_TARGET_GROUP) {
+		err = bt_mesh_cfg_cli_mod_sub_del(net_idx, tester_addr, tester_addr,
+						  BURST_GROUP_ADDR, BT_MESH_MODEL_ID_HEALTH_SRV,
+						  &status);
+		if (err || status) {
+			LOG_WRN("Tester group unsubscription failed (err %d, status %u)", err,
+				status);
+		}
+	}
+
+	LOG_INF("Burst mode %s, %d DUTs, %d burst sizes, %d iterations each",
+		burst_mode ? burst_mode : "dut", dut_n, burst_size_count, max_iterations);
+
+	for (int phase = 0; phase < burst_size_count; phase++) {
+		int k = burst_sizes[phase];
+		struct burst_stats *st = &stats[phase];
+
+		LOG_INF("Burst size %d: from %lld ms", k, k_uptime_get());
+
+		for (int i = 0; i < max_iterations; i++) {
+			switch (target) {
+			case BURST_TARGET_DUT:
+				for (int d = 0; d < dut_n; d++) {
+					for (int j = 0; j < k; j++) {
+						dst[j] = duts[d];
+					}
+
+					burst_run(dst, k, 1, st);
+				}
+				break;
+			case BURST_TARGET_MULTI:
+				/* The DUTs in turn, continuing where the previous burst ended */
+				for (int j = 0; j < k; j++) {
+					dst[j] = duts[next++ % dut_n];
+				}
+
+				burst_run(dst, k, 1, st);
+				break;
+			case BURST_TARGET_GROUP:
+				for (int j = 0; j < k; j++) {
+					dst[j] = BURST_GROUP_ADDR;
+				}
+
+				burst_run(dst, k, dut_n, st);
+				break;
+			}
+		}
+
+		if (!phase) {
+			base_p50 = burst_percentile(st, 50);
+		}
+
+		burst_report(k, st, base_p50);
+	}
+
+	LOG_INF("Burst results (responses timed from the start of their burst):");
+	for (int phase = 0; phase < burst_size_count; phase++) {
+		burst_report(burst_sizes[phase], &stats[phase], base_p50);
+	}
 
 	PASS();
 
@@ -248,6 +843,13 @@ static void test_pre_init(void)
 static void test_terminate(void)
 {
 	bt_mesh_tst_conn_adv_cnt_finish();
+	proxy_load_report();
+	bt_mesh_tst_trace_dump();
+	bt_mesh_tst_prof_report();
+	bt_mesh_tst_bufs_report();
+	bt_mesh_tst_links_report();
+	bt_mesh_tst_cache_report();
+	bt_mesh_tst_zone_report();
 }
 
 #define TEST_CASE(role, name, description)                       \
@@ -256,7 +858,7 @@ static void test_terminate(void)
 		.test_descr = description,                       \
 		.test_pre_init_f = test_pre_init,                \
 		.test_tick_f = bt_mesh_test_timeout,             \
-		.test_args_f = test_args_parse,                  \
+		.test_args_f = bt_mesh_tst_args_parse,          \
 		.test_post_init_f = test_##role##_##name##_init, \
 		.test_main_f = test_##role##_##name,             \
 		.test_delete_f = test_terminate,              \
@@ -265,6 +867,8 @@ static void test_terminate(void)
 static const struct bst_test_instance test_network[] = {
 	TEST_CASE(node, device, "Nodes in the network"),
 	TEST_CASE(node, tester, "tester device"),
+	TEST_CASE(node, proxy_tester, "tester device entering the mesh through a GATT proxy"),
+	TEST_CASE(node, burst_tester, "tester device sending back-to-back request bursts"),
 	BSTEST_END_MARKER
 };
 
@@ -6,6 +6,8 @@
 #include "mesh_test.h"
 
 #include <zephyr/kernel.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/crc.h>
 #include <bluetooth/mesh/models.h>
 #include <zephyr/bluetooth/mesh/proxy.h>
 #include "bs_tracing.h"
@@ -20,6 +22,9 @@
 LOG_MODULE_REGISTER(LOG_MODULE_NAME);
 
 extern int max_iterations;
+extern int run_seed;
+extern int quiet_ms;
+extern int quiet_max_ms;
 extern int dut_list[MAX_DEVICES];
 extern int dut_count;
 extern int net_id_counts;
@@ -69,31 +74,111 @@ static const struct bt_mesh_vendor_srv_handlers vendor_srv_handlers = {
 /* Server model instance */
 static struct bt_mesh_vendor_srv vendor_srv = BT_MESH_VENDOR_SRV_INIT(&vendor_srv_handlers);
 
+/* Every SET and STATUS payload starts with a sequence number and a CRC32 (IEEE) followed by the
+ * message body. The CRC covers the body and then the sequence number, so the sender only has to
+ * extend the precomputed CRC of its constant body with the 4 sequence number bytes. A GET has no
+ * sequence number, its STATUS carries GET_SEQ.
+ */
+#define PAYLOAD_HDR_LEN (sizeof(uint32_t) * 2)
+
+/* Sequence number of a STATUS answering a GET, SET sequence numbers start at 1 */
+#define GET_SEQ (0)
+
+/* SET payload, built once and reused for every request. Only the header is rewritten in place
+ * before each send, the body is never copied again.
+ */
+NET_BUF_SIMPLE_DEFINE_STATIC(set_buf, BT_MESH_VENDOR_MSG_MAXLEN_SET);
+static size_t set_body_len;
+static uint32_t set_body_crc;
+
+static size_t status_body_len;
+static uint32_t status_body_crc;
+
+/* Sequence number of the outstanding SET and of the last SET seen from each source address */
+static uint32_t tx_seq;
+static uint32_t last_set_seq[MAX_DEVICES + 1];
+
+/* Integrity check results */
+static uint32_t corrupt_cnt;
+static uint32_t misordered_cnt;
+
+/* TTL of the last STATUS received by the client */
+static uint8_t status_recv_ttl;
+
+static uint32_t payload_crc(uint32_t body_crc, const uint8_t *seq_le)
+{
+	return crc32_ieee_update(body_crc, seq_le, sizeof(uint32_t));
+}
+
+static void payload_init(void)
+{
+	set_body_len = MIN(strlen(set_msg), BT_MESH_VENDOR_MSG_MAXLEN_SET - PAYLOAD_HDR_LEN);
+	set_body_crc = crc32_ieee((const uint8_t *)set_msg, set_body_len);
+
+	status_body_len = MIN(strlen(status_msg),
+			      BT_MESH_VENDOR_MSG_MAXLEN_STATUS - PAYLOAD_HDR_LEN);
+	status_body_crc = crc32_ieee((const uint8_t *)status_msg, status_body_len);
+
+	net_buf_simple_reset(&set_buf);
+	net_buf_simple_add(&set_buf, PAYLOAD_HDR_LEN);
+	net_buf_simple_add_mem(&set_buf, set_msg, set_body_len);
+}
+
+/* Write sequence number and CRC into the header of a payload whose body is already in place */
+static void payload_hdr_set(uint8_t *hdr, uint32_t seq, uint32_t body_crc)
+{
+	sys_put_le32(seq, hdr);
+	sys_put_le32(payload_crc(body_crc, hdr), hdr + sizeof(uint32_t));
+}
+
+/* Verify a received payload in place. Returns 0 and the sequence number on success. */
+static int payload_verify(const struct net_buf_simple *buf, uint32_t *seq)
+{
+	uint32_t crc;
+
+	if (buf->len < PAYLOAD_HDR_LEN) {
+		return -EMSGSIZE;
+	}
+
+	crc = crc32_ieee(buf->data + PAYLOAD_HDR_LEN, buf->len - PAYLOAD_HDR_LEN);
+	if (payload_crc(crc, buf->data) != sys_get_le32(buf->data + sizeof(uint32_t))) {
+		return -EBADMSG;
+	}
+
+	*seq = sys_get_le32(buf->data);
+	return 0;
+}
+
 /* Server set callback */
 static int handle_vendor_set(struct bt_mesh_vendor_srv *srv,
 				struct bt_mesh_msg_ctx *ctx,
 				const struct bt_mesh_vendor_set *set,
 				struct bt_mesh_vendor_status *rsp)
 {
-	char data[BT_MESH_VENDOR_MSG_MAXLEN_SET + 1] = {0};
-	size_t len = set->buf->len;
+	uint32_t seq = 0;
+	int err;
 
-	/* Safety check for buffer size */
-	if (len > BT_MESH_VENDOR_MSG_MAXLEN_SET) {
-		len = BT_MESH_VENDOR_MSG_MAXLEN_SET;
-	}
+	err = payload_verify(set->buf, &seq);
+	if (err) {
+		corrupt_cnt++;
+		LOG_ERR("Corrupt SET from 0x%04x (len %u, err %d)", ctx->addr, set->buf->len, err);
+	} else if (ctx->addr <= MAX_DEVICES) {
+		/* Sequence numbers may skip after a lost exchange, but never go backwards */
+		if (seq <= last_set_seq[ctx->addr] && last_set_seq[ctx->addr] != 0) {
+			misordered_cnt++;
+			LOG_WRN("Misordered SET from 0x%04x: seq %u after %u", ctx->addr, seq,
+				last_set_seq[ctx->addr]);
+		}
 
-	/* Copy data for display */
-	if (len > 0) {
-		memcpy(data, set->buf->data, len);
-		data[len] = '\0'; /* Null-terminate the string */
+		last_set_seq[ctx->addr] = seq;
 	}
 
-	LOG_DBG("Received SET message: \"%s\"", data);
+	LOG_DBG("Received SET message: seq %u len %u", seq, set->buf->len);
 
-	/* Populate the response status message */
+	/* Populate the response status message, echoing the request sequence number */
 	net_buf_simple_reset(rsp->buf);
-	net_buf_simple_add_mem(rsp->buf, status_msg, strlen(status_msg));
+	payload_hdr_set(net_buf_simple_add(rsp->buf, PAYLOAD_HDR_LEN), seq, status_body_crc);
+	net_buf_simple_add_mem(rsp->buf, status_msg, status_body_len);
 
 	return 0; /* Return success to send response immediately */
 }
@@ -104,9 +189,9 @@ static int handle_vendor_get(struct bt_mesh_vendor_srv *srv,
 				const struct bt_mesh_vendor_get *get,
 				struct bt_mesh_vendor_status *rsp)
 {
-	size_t len = strlen(status_msg);
+	size_t len = status_body_len;
 
-	/* Check if length parameter is provided and limit response accordingly */
+	/* Check if length parameter is provided and limit response body accordingly */
 	if (get) {
 		len = (get->length < len) ? get->length : len;
 
@@ -115,11 +200,14 @@ static int handle_vendor_get(struct bt_mesh_vendor_srv *srv,
 		LOG_INF("GET without length, sending full response");
 	}
 
-	/* Populate the response status message */
+	/* Populate the response status message, a shortened body needs its own CRC */
 	net_buf_simple_reset(rsp->buf);
+	payload_hdr_set(net_buf_simple_add(rsp->buf, PAYLOAD_HDR_LEN), GET_SEQ,
+			len == status_body_len ? status_body_crc :
+			crc32_ieee((const uint8_t *)status_msg, len));
 	net_buf_simple_add_mem(rsp->buf, status_msg, len);
 
-	LOG_INF("Sending STATUS response with length: %zu", len);
+	LOG_INF("Sending STATUS response with length: %u", rsp->buf->len);
 
 	return 0; /* Return success to send response immediately */
 }
@@ -139,48 +227,49 @@ static void handle_vendor_status(struct bt_mesh_vendor_cli *cli,
 				  struct bt_mesh_msg_ctx *ctx,
 				  const struct bt_mesh_vendor_status *status)
 {
-	char data[BT_MESH_VENDOR_MSG_MAXLEN_STATUS + 1] = {0};
-	size_t len = status->buf->len;
-
-	if (len > BT_MESH_VENDOR_MSG_MAXLEN_STATUS) {
-		len = BT_MESH_VENDOR_MSG_MAXLEN_STATUS;
-	}
+	uint32_t seq = 0;
+	int err;
 
-	if (len > 0) {
-		memcpy(data, status->buf->data, len);
-		data[len] = '\0'; /* Null-terminate the string */
+	status_recv_ttl = ctx->recv_ttl;
+
+	err = payload_verify(status->buf, &seq);
+	if (err) {
+		corrupt_cnt++;
+		LOG_ERR("Corrupt STATUS from 0x%04x (len %u, err %d)", ctx->addr, status->buf->len,
+			err);
+	} else if (seq != GET_SEQ && seq != tx_seq) {
+		/* Late response to an earlier request that already timed out */
+		misordered_cnt++;
+		LOG_WRN("STATUS from 0x%04x for seq %u, expected %u", ctx->addr, seq, tx_seq);
 	}
 
-	LOG_DBG("Received STATUS: len %d ttl %d", len, ctx->recv_ttl);
+	LOG_DBG("Received STATUS: seq %u len %d ttl %d", seq, status->buf->len, ctx->recv_ttl);
 }
 
 
-int vendor_model_send_set(const uint8_t *data, size_t len, struct bt_mesh_msg_ctx *ctx,
-			  struct bt_mesh_vendor_status *rsp)
+int vendor_model_send_set(struct bt_mesh_msg_ctx *ctx, struct bt_mesh_vendor_status *rsp)
 {
-	LOG_DBG("Sending SET message: \"%s\" (%d)", (char *)data, len);
-
-	NET_BUF_SIMPLE_DEFINE(temp_buf, BT_MESH_VENDOR_MSG_MAXLEN_SET);
-	net_buf_simple_add_mem(&temp_buf, data, len);
-
 	struct bt_mesh_vendor_set set = {
-		.buf = &temp_buf
+		.buf = &set_buf
 	};
 
+	payload_hdr_set(set_buf.data, ++tx_seq, set_body_crc);
+
+	LOG_DBG("Sending SET message: seq %u (%d)", tx_seq, set_buf.len);
+
 	return bt_mesh_vendor_cli_set(&vendor_cli, ctx, &set, rsp);
 }
 
-int vendor_model_send_set_unack(const uint8_t *data, size_t len, struct bt_mesh_msg_ctx *ctx)
+int vendor_model_send_set_unack(struct bt_mesh_msg_ctx *ctx)
 {
-	LOG_DBG("Sending SET UNACK message: \"%s\" (%d)", (char *)data, len);
-
-	NET_BUF_SIMPLE_DEFINE(temp_buf, BT_MESH_VENDOR_MSG_MAXLEN_SET);
-	net_buf_simple_add_mem(&temp_buf, data, len);
-
 	struct bt_mesh_vendor_set set = {
-		.buf = &temp_buf
+		.buf = &set_buf
 	};
 
+	payload_hdr_set(set_buf.data, ++tx_seq, set_body_crc);
+
+	LOG_DBG("Sending SET UNACK message: seq %u (%d)", tx_seq, set_buf.len);
+
 	return bt_mesh_vendor_cli_set_unack(&vendor_cli, ctx, &set);
 }
 
@@ -236,6 +325,7 @@ static void dev_prov_and_conf(uint16_t addr)
 static void test_vnd_node_device_init(void)
 {
 	bt_mesh_test_cfg_set(WAIT_TIME);
+	payload_init();
 }
 
 static void test_vnd_node_device(void)
@@ -246,12 +336,16 @@ static void test_vnd_node_device(void)
 	bt_mesh_device_setup(&prov, &comp);
 	dev_prov_and_conf(bsim_args_get_global_device_nbr() + 1);
 
+	bt_mesh_tst_hb_discovery(bsim_args_get_global_device_nbr() + 1, false);
+	bt_mesh_tst_prof_phase("measurement");
+
 	PASS();
 }
 
 static void test_vnd_node_tester_init(void)
 {
 	bt_mesh_test_cfg_set(WAIT_TIME);
+	payload_init();
 }
 
 static void test_vnd_node_tester(void)
@@ -277,6 +371,10 @@ static void test_vnd_node_tester(void)
 	dev_prov_and_conf(tester_addr);
 
 	LOG_INF("Using MAX_ITERATIONS: %d", max_iterations);
+	if (run_seed >= 0) {
+		LOG_INF("Run seed: %d", run_seed);
+	}
+	LOG_INF("Inter-probe quiet window: %d ms (max %d ms)", quiet_ms, quiet_max_ms);
 
 	/* Print DUT list if specified */
 	if (dut_count > 0) {
@@ -286,9 +384,19 @@ static void test_vnd_node_tester(void)
 		}
 	}
 
+	bt_mesh_tst_hb_discovery(tester_addr, true);
+	bt_mesh_tst_prof_phase("measurement");
+
 	/* For each node, send attention get 10 times and store latency information */
 	struct bt_mesh_vendor_status rsp = {0};
 	struct bt_mesh_msg_ctx ctx = {0};
+	int duts = 0;
+
+	for (int dut = 0; dut < total_nodes; dut++) {
+		duts += is_dut(dut, dut_list, dut_count);
+	}
+
+	bt_mesh_tst_metrics_plan(duts);
 
 	for(int dut = 0; dut < total_nodes; dut++)
 	{
@@ -315,29 +423,36 @@ static void test_vnd_node_tester(void)
 			ctx.send_rel = 0;
 
 			t1 = k_uptime_get();
-			err = vendor_model_send_set((const uint8_t *)set_msg, strlen(set_msg),
-						    &ctx, &rsp);
+			err = vendor_model_send_set(&ctx, &rsp);
 
 			if (err) {
 				LOG_ERR("Vendor Set failed (err %d)", err);
 				tst_res[dut].failures++;
-				k_sleep(K_MSEC(200));
+				bt_mesh_tst_metrics_probe(0, false);
+				bt_mesh_tst_wait_quiet();
 				continue;
 			}
 
 			t2 = k_uptime_get();
 			tst_res[dut].latency[i] = t2 - t1;
+			tst_res[dut].ttl[i] = status_recv_ttl;
 
 			LOG_INF("Latency: %d", tst_res[dut].latency[i]);
+			bt_mesh_tst_metrics_probe(tst_res[dut].latency[i], true);
 
-			k_sleep(K_MSEC(1500));
+			bt_mesh_tst_wait_quiet();
 		}
 
 		LOG_INF("Network ID advertisements count %d", net_id_counts);
+		bt_mesh_tst_metrics_dut_done();
 	}
 
+	bt_mesh_tst_metrics_finish();
 	print_common_results(total_nodes, max_iterations);
 
+	LOG_INF("Payload integrity: %u sent, %u corrupt, %u misordered", tx_seq, corrupt_cnt,
+		misordered_cnt);
+
 	PASS();
 
 	bs_trace_silent_exit(0);
@@ -351,40 +466,16 @@ static void test_pre_init(void)
 static void test_terminate(void)
 {
 	bt_mesh_tst_conn_adv_cnt_finish();
-}
-
-/* Parse command line arguments */
-static void test_args_parse(int argc, char *argv[])
-{
-	static char *duts_str;
-
-	bs_args_struct_t args_struct[] = {
-		{
-			.dest = &max_iterations,
-			.type = 'i',
-			.name = "{integer}",
-			.option = "iterations",
-			.descript = "Number of iterations to run for each test"
-		},
-		{
-			.dest = &duts_str,
-			.type = 's',
-			.name = "{string}",
-			.option = "duts",
-			.descript = "Comma-separated list of DUT indices to test"
-		},
-		ARG_TABLE_ENDMARKER
-	};
-
-	bs_args_parse_all_cmd_line(argc, argv, args_struct);
-
-	if (max_iterations < 1 || max_iterations > MAX_ITERATIONS) {
-		FAIL("Invalid number of given iterations %d. Max allowed %d", max_iterations,
-		     MAX_ITERATIONS);
+	bt_mesh_tst_trace_dump();
+	bt_mesh_tst_prof_report();
+	bt_mesh_tst_bufs_report();
+	bt_mesh_tst_links_report();
+	bt_mesh_tst_cache_report();
+
+	if (corrupt_cnt || misordered_cnt) {
+		LOG_ERR("Payload integrity: %u corrupt, %u misordered", corrupt_cnt,
+			misordered_cnt);
 	}
-
-	dut_count = ARRAY_SIZE(dut_list);
-	parse_dut_list(duts_str, dut_list, &dut_count);
 }
 
 #define TEST_CASE(role, name, description)                       \
@@ -393,7 +484,7 @@ static void test_args_parse(int argc, char *argv[])
 		.test_descr = description,                       \
 		.test_pre_init_f = test_pre_init,                \
 		.test_tick_f = bt_mesh_test_timeout,             \
-		.test_args_f = test_args_parse,                  \
+		.test_args_f = bt_mesh_tst_args_parse,          \
 		.test_post_init_f = test_##role##_##name##_init, \
 		.test_main_f = test_##role##_##name,             \
 		.test_delete_f = test_terminate,                 \
@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Simulation speed profiling, enabled with prof_period_ms. Every device process samples its
+ * simulated time against the host wall-clock time and its own CPU time, and records the same
+ * at the start of each test phase (setup, provisioning, configuration, discovery, measurement).
+ * All processes advance in lockstep with the phy, so in every interval the process with the
+ * highest CPU use is the one the others wait for. helper_sim_profile.py names these processes
+ * and phases from the "Prof" lines logged at exit.
+ */
+
+#include "mesh_test.h"
+#include "native/mesh_host.h"
+
+#include <zephyr/kernel.h>
+#include "bs_tracing.h"
+#include "bsim_args_runner.h"
+
+#define LOG_MODULE_NAME mesh_profile
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(LOG_MODULE_NAME);
+
+extern int prof_period_ms;
+extern int resync_us;
+
+#define PROF_MAX_PHASES  (8)
+
+/* When the sample buffer is full, every other sample is dropped and the period doubled, so a
+ * run of any length is covered with at most this many samples.
+ */
+#define PROF_MAX_SAMPLES (64)
+
+struct prof_point {
+	int64_t sim_ms;
+	int64_t wall_us;
+	int64_t cpu_us;
+};
+
+static struct {
+	const char *name;
+	struct prof_point start;
+} phases[PROF_MAX_PHASES];
+
+static int phase_count;
+static struct prof_point samples[PROF_MAX_SAMPLES];
+static int sample_count;
+static int sample_period_ms;
+static struct k_work_delayable prof_work;
+
+static void prof_point_get(struct prof_point *p)
+{
+	p->sim_ms = k_uptime_get();
+	p->wall_us = mesh_host_wall_time_us();
+	p->cpu_us = mesh_host_cpu_time_us();
+}
+
+static void prof_sample(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	if (sample_count == PROF_MAX_SAMPLES) {
+		for (int i = 0; i < PROF_MAX_SAMPLES / 2; i++) {
+			samples[i] = samples[2 * i + 1];
+		}
+
+		sample_count = PROF_MAX_SAMPLES / 2;
+		sample_period_ms *= 2;
+	}
+
+	prof_point_get(&samples[sample_count++]);
+	k_work_schedule(&prof_work, K_MSEC(sample_period_ms));
+}
+
+void bt_mesh_tst_prof_phase(const char *name)
+{
+	if (!prof_period_ms) {
+		return;
+	}
+
+	if (phase_count == PROF_MAX_PHASES) {
+		LOG_WRN("Too many profiling phases, %s is counted in %s", name,
+			phases[phase_count - 1].name);
+		return;
+	}
+
+	phases[phase_count].name = name;
+	prof_point_get(&phases[phase_count].start);
+
+	/* The first phase starts the periodic sampling */
+	if (!phase_count++) {
+		sample_period_ms = prof_period_ms;
+		samples[sample_count++] = phases[0].start;
+		k_work_init_delayable(&prof_work, prof_sample);
+		k_work_schedule(&prof_work, K_MSEC(sample_period_ms));
+	}
+}
+
+static void prof_span_print(int dev, const char *name, const struct prof_point *from,
+			    const struct prof_point *to)
+{
+	int64_t sim_ms = to->sim_ms - from->sim_ms;
+	int64_t wall_ms = MAX((to->wall_us - from->wall_us) / 1000, 1);
+	int64_t cpu_ms = (to->cpu_us - from->cpu_us) / 1000;
+
+	LOG_INF("Prof dev %d phase %s: sim %lld ms wall %lld ms cpu %lld ms speed %lld.%03lld "
+		"cpu %lld%%", dev, name, sim_ms, wall_ms, cpu_ms, sim_ms / wall_ms,
+		sim_ms * 1000 / wall_ms % 1000, cpu_ms * 100 / wall_ms);
+}
+
+void bt_mesh_tst_prof_report(void)
+{
+	int dev = bsim_args_get_global_device_nbr();
+	struct prof_point now;
+
+	if (!prof_period_ms || !phase_count) {
+		return;
+	}
+
+	k_work_cancel_delayable(&prof_work);
+	prof_point_get(&now);
+
+	/* Compacting the samples drops the first one, so the start of the first phase is logged */
+	LOG_INF("Prof dev %d: %d samples every %d ms, phy resync offset %d us, first phase at sim "
+		"%lld ms", dev, sample_count, sample_period_ms, resync_us, phases[0].start.sim_ms);
+
+	/* Cumulative since the first phase started, so the summary can take any differences */
+	for (int i = 0; i < sample_count; i++) {
+		LOG_INF("Prof dev %d sample sim %lld wall %lld cpu %lld", dev, samples[i].sim_ms,
+			(samples[i].wall_us - phases[0].start.wall_us) / 1000,
+			(samples[i].cpu_us - phases[0].start.cpu_us) / 1000);
+	}
+
+	for (int i = 0; i < phase_count; i++) {
+		prof_span_print(dev, phases[i].name, &phases[i].start,
+				i + 1 < phase_count ? &phases[i + 1].start : &now);
+	}
+
+	prof_span_print(dev, "total", &phases[0].start, &now);
+}
@@ -7,7 +7,10 @@
 #include "mesh_test.h"
 
 #include <zephyr/kernel.h>
+#include <zephyr/sys/byteorder.h>
 #include "bs_tracing.h"
+#include "bs_cmd_line.h"
+#include "bsim_args_runner.h"
 #include "time_machine.h"
 
 #define LOG_MODULE_NAME mesh_test
@@ -17,6 +20,66 @@ LOG_MODULE_REGISTER(LOG_MODULE_NAME);
 /* Common test variables */
 int max_iterations = DEF_ITERATIONS;
 
+/* Inter-probe pacing */
+int quiet_ms = DEF_QUIET_MS;
+int quiet_max_ms = DEF_QUIET_MAX_MS;
+
+/* Background interferers */
+char *intf_mode;
+int intf_interval_ms = DEF_INTF_INTERVAL_MS;
+int intf_period_ms = DEF_INTF_PERIOD_MS;
+int intf_duty = DEF_INTF_DUTY;
+int intf_len = DEF_INTF_LEN;
+
+/* GATT proxy ingress: device index of the serving proxy node, and connection interval */
+int proxy_node = -1;
+int proxy_conn_int_ms;
+
+/* Convergecast: per-phase report period of every source, and report shape */
+int cc_periods[CC_MAX_PHASES] = { 5000 };
+int cc_phase_count = 1;
+int cc_phase_ms = DEF_CC_PHASE_MS;
+int cc_jitter_ms = DEF_CC_JITTER_MS;
+int cc_len = DEF_CC_LEN;
+int cc_sink = -1;
+int cc_sat_pct = DEF_CC_SAT_PCT;
+int cc_group;
+
+/* Burst probing: requests per burst, one entry per measurement phase, and their targets */
+int burst_sizes[BURST_MAX_PHASES];
+int burst_size_count;
+char *burst_mode;
+
+/* Seed the run was started with (-1: default seeds), for the record only. The processes get
+ * their own seeds derived from it by the test scripts.
+ */
+int run_seed = -1;
+
+/* Number of nodes in the network (devices and tester), for roles that need it up front */
+int node_count;
+
+/* Heartbeat hop count discovery: slot length per source (0: off) and heartbeats per source */
+int hb_slot_ms;
+int hb_count = 1;
+
+/* Zone (subnet) of every device index, nodes joining all zones, and single-subnet baseline */
+int zone_map[MAX_DEVICES];
+int zone_count;
+int zone_border[MAX_DEVICES];
+int zone_border_count;
+int zone_flat;
+
+/* Directory the relay path traces are written to (NULL: no tracing) */
+char *trace_dir;
+
+/* Simulation speed profiling sample period (0: off), and phy resync offset */
+int prof_period_ms;
+int resync_us = DEF_RESYNC_US;
+
+/* Live metrics output file, and update period */
+char *metrics_file;
+int metrics_period_ms = DEF_METRICS_PERIOD_MS;
+
 /* DUT list handling */
 int dut_list[MAX_DEVICES];
 int dut_count = 0;
@@ -31,15 +94,47 @@ uint8_t net_idx = 0;
 
 struct test_results tst_res[MAX_DEVICES];
 
+/* Uptime at which the scanner last saw a mesh network PDU */
+static int64_t last_mesh_rx_ms;
+
+/* Check if advertising data contains the given AD type, without consuming the buffer */
+static bool adv_data_has_type(const struct net_buf_simple *buf, uint8_t type)
+{
+	const uint8_t *data = buf->data;
+	size_t left = buf->len;
+
+	while (left > 1) {
+		uint8_t len = data[0];
+
+		if (len == 0 || len >= left) {
+			return false;
+		}
+
+		if (data[1] == type) {
+			return true;
+		}
+
+		data += len + 1;
+		left -= len + 1;
+	}
+
+	return false;
+}
 
 /* Scanner callback function */
 static void scan_packet_recv(const struct bt_le_scan_recv_info *info, struct net_buf_simple *buf)
 {
+    bt_mesh_tst_links_adv(info);
+
     if (info->adv_type == BT_GAP_ADV_TYPE_ADV_IND) {
         /* FIXME: Parse advertisement data and find out Mesh Proxy Service */
 
 	// since this is simulation
         net_id_counts++;
+    } else if (info->adv_type == BT_GAP_ADV_TYPE_ADV_NONCONN_IND &&
+	       adv_data_has_type(buf, BT_DATA_MESH_MESSAGE)) {
+	last_mesh_rx_ms = k_uptime_get();
+	bt_mesh_tst_trace_adv(info, buf);
     }
 }
 
@@ -52,10 +147,18 @@ void bt_mesh_tst_provision(uint16_t addr)
 {
 	int err;
 
+	bt_mesh_tst_prof_phase("provisioning");
+
 	/* Each device's device key is dddd...<addr> */
 	dev_key[0] = addr & 0xFF;
 	dev_key[1] = addr >> 8;
 
+	/* Join the subnet of our zone, see mesh_zones.c. Zone 0 keeps the default keys. */
+	net_idx = bt_mesh_tst_zone_net_idx(addr - 1);
+	app_idx = net_idx;
+	bt_mesh_tst_zone_key(net_key, net_idx, net_key);
+	bt_mesh_tst_zone_key(app_key, app_idx, app_key);
+
 	err = bt_mesh_provision(net_key, net_idx, 0, 0, addr, dev_key);
 	if (err) {
 		FAIL("Provisioning failed (err %d)", err);
@@ -70,6 +173,8 @@ void bt_mesh_tst_common_configure(uint16_t addr)
 	uint8_t status;
 	int err;
 
+	bt_mesh_tst_prof_phase("configuration");
+
 	/* Add App Key */
 	err = bt_mesh_cfg_cli_app_key_add(net_idx, addr, net_idx, app_idx, app_key,
 					  &status);
@@ -78,6 +183,8 @@ void bt_mesh_tst_common_configure(uint16_t addr)
 		return;
 	}
 
+	bt_mesh_tst_zone_configure(addr);
+
 	/* Change default TTL to suit the maximum network size*/
 	uint8_t ttl_status;
 	err = bt_mesh_cfg_cli_ttl_set(net_idx, addr, MAX_TTL, &ttl_status);
@@ -123,10 +230,37 @@ void bt_mesh_tst_conn_adv_cnt_finish(void)
 }
 
 
+int bt_mesh_tst_id_addr_dev(const bt_addr_le_t *addr)
+{
+	if (addr->type != BT_ADDR_LE_RANDOM || addr->a.val[5] != BT_MESH_TST_ID_ADDR_MSB ||
+	    addr->a.val[4] || addr->a.val[3] || addr->a.val[2]) {
+		return -1;
+	}
+
+	return sys_get_le16(addr->a.val) - 1;
+}
+
 void bt_mesh_device_setup(const struct bt_mesh_prov *prov, const struct bt_mesh_comp *comp)
 {
+	/* Device number + 1, the random part of a static address must not be all zeros */
+	uint16_t nbr = bsim_args_get_global_device_nbr() + 1;
+	bt_addr_le_t id_addr = {
+		.type = BT_ADDR_LE_RANDOM,
+		.a.val = { nbr & 0xff, nbr >> 8, 0, 0, 0, BT_MESH_TST_ID_ADDR_MSB },
+	};
 	int err;
 
+	bt_mesh_tst_prof_phase("setup");
+
+	/* Must be set before Bluetooth is enabled to become the identity address */
+	if (IS_ENABLED(CONFIG_BT_MESH_DEBUG_USE_ID_ADDR)) {
+		err = bt_id_create(&id_addr, NULL);
+		if (err < 0) {
+			FAIL("Identity address setup failed (err %d)", err);
+			return;
+		}
+	}
+
 	err = bt_enable(NULL);
 	if (err) {
 		FAIL("Bluetooth init failed (err %d)", err);
@@ -168,9 +302,359 @@ void bt_mesh_test_cfg_set(int wait_time)
 	bst_result = In_progress;
 
 	/* Ensure those test devices will not drift more than
-	 * 100ms for each other in emulated time
+	 * resync_us (100ms by default) for each other in emulated time
 	 */
-	tm_set_phy_max_resync_offset(100000);
+	tm_set_phy_max_resync_offset(resync_us);
+}
+
+int64_t bt_mesh_tst_wait_quiet(void)
+{
+	int64_t start = k_uptime_get();
+	int64_t now = start;
+
+	/* Relay retransmissions of the previous exchange may still be in the air. Sleep until
+	 * the scanner has been idle for the whole quiet window, re-arming whenever a new PDU
+	 * shows up, but never longer than the configured maximum.
+	 */
+	while (now - start < quiet_max_ms) {
+		int64_t idle = now - last_mesh_rx_ms;
+
+		if (idle >= quiet_ms) {
+			break;
+		}
+
+		k_sleep(K_MSEC(MIN(quiet_ms - idle, quiet_max_ms - (now - start))));
+		now = k_uptime_get();
+	}
+
+	return now - start;
+}
+
+/* Parse command line arguments */
+void bt_mesh_tst_args_parse(int argc, char *argv[])
+{
+	static char *duts_str;
+	static char *cc_periods_str;
+	static char *burst_sizes_str;
+	static char *zone_map_str;
+	static char *zone_border_str;
+
+	bs_args_struct_t args_struct[] = {
+		{
+			.dest = &max_iterations,
+			.type = 'i',
+			.name = "{integer}",
+			.option = "iterations",
+			.descript = "Number of iterations to run for each test"
+		},
+		{
+			.dest = &duts_str,
+			.type = 's',
+			.name = "{string}",
+			.option = "duts",
+			.descript = "Comma-separated list of DUT indices to test"
+		},
+		{
+			.dest = &quiet_ms,
+			.type = 'i',
+			.name = "{integer}",
+			.option = "quiet_ms",
+			.descript = "Idle time (ms) without mesh PDUs before the next probe is sent"
+		},
+		{
+			.dest = &quiet_max_ms,
+			.type = 'i',
+			.name = "{integer}",
+			.option = "quiet_max_ms",
+			.descript = "Maximum time (ms) to wait for a quiet network between probes"
+		},
+		{
+			.dest = &intf_mode,
+			.type = 's',
+			.name = "{adv_legacy|adv_ext|scan}",
+			.option = "intf_mode",
+			.descript = "Interferer role: legacy or extended advertiser, or active scanner"
+		},
+		{
+			.dest = &intf_interval_ms,
+			.type = 'i',
+			.name = "{integer}",
+			.option = "intf_interval_ms",
+			.descript = "Interferer advertising or scan interval (ms)"
+		},
+		{
+			.dest = &intf_period_ms,
+			.type = 'i',
+			.name = "{integer}",
+			.option = "intf_period_ms",
+			.descript = "Interferer on/off cycle length (ms)"
+		},
+		{
+			.dest = &intf_duty,
+			.type = 'i',
+			.name = "{integer}",
+			.option = "intf_duty",
+			.descript = "Percentage of each cycle the interferer is active"
+		},
+		{
+			.dest = &intf_len,
+			.type = 'i',
+			.name = "{integer}",
+			.option = "intf_len",
+			.descript = "Interferer advertising data length (bytes)"
+		},
+		{
+			.dest = &proxy_node,
+			.type = 'i',
+			.name = "{integer}",
+			.option = "proxy_node",
+			.descript = "Device index of the only node acting as GATT proxy (-1: all nodes)"
+		},
+		{
+			.dest = &proxy_conn_int_ms,
+			.type = 'i',
+			.name = "{integer}",
+			.option = "proxy_conn_int_ms",
+			.descript = "Connection interval (ms) requested by the proxy client (0: default)"
+		},
+		{
+			.dest = &cc_periods_str,
+			.type = 's',
+			.name = "{string}",
+			.option = "cc_periods",
+			.descript = "Comma-separated report period (ms) of each source, one per load phase"
+		},
+		{
+			.dest = &cc_phase_ms,
+			.type = 'i',
+			.name = "{integer}",
+			.option = "cc_phase_ms",
+			.descript = "Duration (ms) of each convergecast load phase"
+		},
+		{
+			.dest = &cc_jitter_ms,
+			.type = 'i',
+			.name = "{integer}",
+			.option = "cc_jitter_ms",
+			.descript = "Random delay (ms) added to each report"
+		},
+		{
+			.dest = &cc_len,
+			.type = 'i',
+			.name = "{integer}",
+			.option = "cc_len",
+			.descript = "Report payload length (bytes), above 8 reports are segmented"
+		},
+		{
+			.dest = &cc_sink,
+			.type = 'i',
+			.name = "{integer}",
+			.option = "cc_sink",
+			.descript = "Device index of the convergecast sink"
+		},
+		{
+			.dest = &cc_sat_pct,
+			.type = 'i',
+			.name = "{integer}",
+			.option = "cc_sat_pct",
+			.descript = "Delivery ratio (%) of the sink's neighbours below which a load phase "
+				    "counts as saturated"
+		},
+		{
+			.dest = &cc_group,
+			.type = 'i',
+			.name = "{integer}",
+			.option = "cc_group",
+			.descript = "Send reports to a group all nodes subscribe to, instead of the sink"
+		},
+		{
+			.dest = &node_count,
+			.type = 'i',
+			.name = "{integer}",
+			.option = "nodes",
+			.descript = "Number of nodes in the network, tester included"
+		},
+		{
+			.dest = &hb_slot_ms,
+			.type = 'i',
+			.name = "{integer}",
+			.option = "hb_slot_ms",
+			.descript = "Heartbeat discovery slot (ms) per source, 0 to skip the discovery"
+		},
+		{
+			.dest = &hb_count,
+			.type = 'i',
+			.name = "{integer}",
+			.option = "hb_count",
+			.descript = "Heartbeats published by each source during discovery (1, 2, 4 or 8)"
+		},
+		{
+			.dest = &run_seed,
+			.type = 'i',
+			.name = "{integer}",
+			.option = "run_seed",
+			.descript = "Run seed the device and phy seeds were derived from"
+		},
+		{
+			.dest = &zone_map_str,
+			.type = 's',
+			.name = "{string}",
+			.option = "zone_map",
+			.descript = "Comma-separated zone (subnet) of each device index (default: 0)"
+		},
+		{
+			.dest = &zone_border_str,
+			.type = 's',
+			.name = "{string}",
+			.option = "zone_border",
+			.descript = "Comma-separated device indices joining every zone to relay between them"
+		},
+		{
+			.dest = &zone_flat,
+			.type = 'i',
+			.name = "{integer}",
+			.option = "zone_flat",
+			.descript = "Keep all nodes on subnet 0, zones only reported (baseline)"
+		},
+		{
+			.dest = &trace_dir,
+			.type = 's',
+			.name = "{string}",
+			.option = "trace_dir",
+			.descript = "Directory to write the relay path trace of every node to at exit"
+		},
+		{
+			.dest = &metrics_file,
+			.type = 's',
+			.name = "{string}",
+			.option = "metrics_file",
+			.descript = "File the tester periodically writes progress metrics to"
+		},
+		{
+			.dest = &metrics_period_ms,
+			.type = 'i',
+			.name = "{integer}",
+			.option = "metrics_period_ms",
+			.descript = "Period (ms of simulated time) of the progress metrics updates"
+		},
+		{
+			.dest = &burst_sizes_str,
+			.type = 's',
+			.name = "{string}",
+			.option = "burst_sizes",
+			.descript = "Comma-separated number of back-to-back requests per burst, one per phase"
+		},
+		{
+			.dest = &burst_mode,
+			.type = 's',
+			.name = "{string}",
+			.option = "burst_mode",
+			.descript = "Burst targets: dut (one DUT), multi (DUTs in turn) or group (all DUTs)"
+		},
+		{
+			.dest = &prof_period_ms,
+			.type = 'i',
+			.name = "{integer}",
+			.option = "prof_period_ms",
+			.descript = "Period (ms of simulated time) of the speed profiling samples, 0 for off"
+		},
+		{
+			.dest = &resync_us,
+			.type = 'i',
+			.name = "{integer}",
+			.option = "resync_us",
+			.descript = "Maximum simulated time drift between devices before resyncing (us)"
+		},
+		ARG_TABLE_ENDMARKER
+	};
+
+	bs_args_parse_all_cmd_line(argc, argv, args_struct);
+
+	if (max_iterations < 1 || max_iterations > MAX_ITERATIONS) {
+		FAIL("Invalid number of given iterations %d. Max allowed %d", max_iterations,
+		     MAX_ITERATIONS);
+	}
+
+	if (quiet_ms < 0 || quiet_max_ms < quiet_ms) {
+		FAIL("Invalid quiet window %d ms (max %d ms)", quiet_ms, quiet_max_ms);
+	}
+
+	if (intf_interval_ms < 20 || intf_period_ms < 1 || intf_duty < 0 || intf_duty > 100) {
+		FAIL("Invalid interferer interval %d ms, period %d ms or duty %d%%",
+		     intf_interval_ms, intf_period_ms, intf_duty);
+	}
+
+	dut_count = ARRAY_SIZE(dut_list);
+	parse_dut_list(duts_str, dut_list, &dut_count);
+
+	if (cc_periods_str) {
+		cc_phase_count = ARRAY_SIZE(cc_periods);
+		parse_dut_list(cc_periods_str, cc_periods, &cc_phase_count);
+	}
+
+	for (int i = 0; i < cc_phase_count; i++) {
+		if (cc_periods[i] < 1 || cc_periods[i] > cc_phase_ms) {
+			FAIL("Invalid report period %d ms for %d ms phases", cc_periods[i],
+			     cc_phase_ms);
+		}
+	}
+
+	if (burst_sizes_str) {
+		burst_size_count = ARRAY_SIZE(burst_sizes);
+		parse_dut_list(burst_sizes_str, burst_sizes, &burst_size_count);
+	}
+
+	for (int i = 0; i < burst_size_count; i++) {
+		if (burst_sizes[i] < 1 || burst_sizes[i] > BURST_MAX_LEN) {
+			FAIL("Invalid burst size %d, must be 1..%d", burst_sizes[i], BURST_MAX_LEN);
+		}
+	}
+
+	if (zone_map_str) {
+		zone_count = ARRAY_SIZE(zone_map);
+		parse_dut_list(zone_map_str, zone_map, &zone_count);
+	}
+
+	for (int i = 0; i < zone_count; i++) {
+		if (zone_map[i] < 0 || zone_map[i] >= CONFIG_BT_MESH_SUBNET_COUNT) {
+			FAIL("Invalid zone %d of device %d, must be 0..%d", zone_map[i], i,
+			     CONFIG_BT_MESH_SUBNET_COUNT - 1);
+		}
+	}
+
+	if (zone_border_str) {
+		zone_border_count = ARRAY_SIZE(zone_border);
+		parse_dut_list(zone_border_str, zone_border, &zone_border_count);
+	}
+
+	if (cc_len < 7 || cc_len > CC_MAX_LEN) {
+		FAIL("Invalid report length %d, must be 7..%d", cc_len, CC_MAX_LEN);
+	}
+
+	if (hb_count < 1 || hb_count > HB_MAX_COUNT || !IS_POWER_OF_TWO(hb_count)) {
+		FAIL("Invalid heartbeat count %d, must be 1, 2, 4 or 8", hb_count);
+	}
+
+	/* Heartbeats of one source are 1 s apart, and the last one must flood the network */
+	if (hb_slot_ms && hb_slot_ms < (hb_count - 1) * 1000 + 200) {
+		FAIL("Heartbeat slot %d ms too short for %d heartbeats", hb_slot_ms, hb_count);
+	}
+
+	if (metrics_period_ms < 100) {
+		FAIL("Invalid metrics period %d ms", metrics_period_ms);
+	}
+
+	if (prof_period_ms < 0 || (prof_period_ms && prof_period_ms < 100)) {
+		FAIL("Invalid profiling period %d ms", prof_period_ms);
+	}
+
+	if (resync_us < 1000) {
+		FAIL("Invalid resync offset %d us", resync_us);
+	}
+
+	if (trace_dir && !IS_ENABLED(CONFIG_BT_MESH_DEBUG_USE_ID_ADDR)) {
+		FAIL("Relay path tracing needs the overlay_id_addr.conf build");
+	}
 }
 
 /* Parse DUT list from string like "0,2,5,6" */
@@ -252,5 +736,56 @@ void print_common_results(int total_nodes, int max_iterations)
 		}
 
 		LOG_INF("%s", latency_str);
+
+		/* Only testers that record the TTL of the responses know the hop count */
+		uint8_t max_recv_ttl = 0;
+
+		for (int i = 0; i < max_iterations; i++) {
+			max_recv_ttl = MAX(max_recv_ttl, tst_res[dut].ttl[i]);
+		}
+
+		if (max_recv_ttl) {
+			LOG_INF("Dev %d hops %d", dut, MAX_TTL - max_recv_ttl + 1);
+		}
 	}
-}
\ No newline at end of file
+}
+
+int64_t bt_mesh_tst_percentile(const int64_t *values, int n, int pct)
+{
+	int64_t sorted[MAX_ITERATIONS];
+
+	n = MIN(n, MAX_ITERATIONS);
+	if (n < 1) {
+		return 0;
+	}
+
+	/* Insertion sort, n is at most MAX_ITERATIONS */
+	for (int i = 0; i < n; i++) {
+		int j = i;
+
+		while (j > 0 && sorted[j - 1] > values[i]) {
+			sorted[j] = sorted[j - 1];
+			j--;
+		}
+
+		sorted[j] = values[i];
+	}
+
+	return sorted[MAX((n * pct + 99) / 100 - 1, 0)];
+}
+
+uint32_t bt_mesh_tst_hist_percentile(const uint32_t *hist, int bins, int bin_ms, uint32_t total,
+				     int pct)
+{
+	uint32_t rank = (total * pct + 99) / 100;
+	uint32_t acc = 0;
+
+	for (int b = 0; b < bins; b++) {
+		acc += hist[b];
+		if (acc >= rank && rank) {
+			return (b + 1) * bin_ms;
+		}
+	}
+
+	return 0;
+}
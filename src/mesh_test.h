@@ -31,6 +31,49 @@
 /* Default number of iterations */
 #define DEF_ITERATIONS 	(10)
 
+/* Network is considered quiet once no mesh PDU was heard for this long */
+#define DEF_QUIET_MS 	(150)
+
+/* Upper bound on the wait for a quiet network between two probes */
+#define DEF_QUIET_MAX_MS (2500)
+
+/* Default background interferer settings */
+#define DEF_INTF_INTERVAL_MS	(100)
+#define DEF_INTF_PERIOD_MS	(1000)
+#define DEF_INTF_DUTY		(100)
+#define DEF_INTF_LEN		(31)
+
+/* Convergecast: maximum number of load phases and report length */
+#define CC_MAX_PHASES		(8)
+#define CC_MAX_LEN		(64)
+
+/* Burst probing: maximum number of burst sizes and requests per burst */
+#define BURST_MAX_PHASES	(8)
+#define BURST_MAX_LEN		(32)
+
+/* Identity addresses are C0:00:00:00:<device nbr + 1>, so receivers can tell the transmitter of
+ * every advertisement. Only set up in the overlay_id_addr.conf build, where mesh advertises with
+ * it (CONFIG_BT_MESH_DEBUG_USE_ID_ADDR).
+ */
+#define BT_MESH_TST_ID_ADDR_MSB	(0xc0)
+
+/* Most heartbeats a device publishes during hop count discovery */
+#define HB_MAX_COUNT		(8)
+
+/* Default limit on how far the devices may run ahead of each other in simulated time. Larger
+ * values let the processes synchronize with the phy less often.
+ */
+#define DEF_RESYNC_US		(100000)
+
+/* Default period of the live metrics updates, in simulated time */
+#define DEF_METRICS_PERIOD_MS	(10000)
+
+/* Default convergecast settings */
+#define DEF_CC_PHASE_MS		(30000)
+#define DEF_CC_JITTER_MS	(100)
+#define DEF_CC_LEN		(8)
+#define DEF_CC_SAT_PCT		(90)
+
 /* Test results */
 struct test_results {
 	uint16_t d_id;
@@ -70,10 +113,21 @@ void bt_mesh_test_timeout(bs_time_t HW_device_time);
 void bt_mesh_tst_provision(uint16_t addr);
 void bt_mesh_tst_common_configure(uint16_t addr);
 void bt_mesh_device_setup(const struct bt_mesh_prov *prov, const struct bt_mesh_comp *comp);
+
+/* Device number of the node advertising with addr, or -1 if it is not a test node */
+int bt_mesh_tst_id_addr_dev(const bt_addr_le_t *addr);
 void bt_mesh_test_cfg_set(int wait_time);
 void bt_mesh_tst_conn_adv_cnt_init(void);
 void bt_mesh_tst_conn_adv_cnt_finish(void);
 
+/* Parse command line arguments common to all test roles */
+void bt_mesh_tst_args_parse(int argc, char *argv[]);
+
+/* Wait until the scanner has not seen any mesh PDU for the configured idle window, or until
+ * the configured maximum wait time elapses. Returns the time waited in milliseconds.
+ */
+int64_t bt_mesh_tst_wait_quiet(void);
+
 /* Parse DUT list from string like "0,2,5,6" */
 void parse_dut_list(const char *dut_str, int *dut_list_out, int *dut_count_out);
 
@@ -82,4 +136,87 @@ bool is_dut(int device_idx, int *dut_list, uint32_t dut_count);
 
 void print_common_results(int total_nodes, int max_iterations);
 
+/* Return the pct-th percentile (nearest rank) of n latency values */
+int64_t bt_mesh_tst_percentile(const int64_t *values, int n, int pct);
+
+/* Return the pct-th percentile (nearest rank) of total values counted in a histogram of bins
+ * bin_ms wide, as the upper edge of its bin. 0 when there are no values.
+ */
+uint32_t bt_mesh_tst_hist_percentile(const uint32_t *hist, int bins, int bin_ms, uint32_t total,
+				     int pct);
+
+/* Heartbeat hop count discovery, run by all nodes when hb_slot_ms is given. Blocks until every
+ * node has had its publication slot, then logs this node's row of the hop matrix. Testers also
+ * log the hop count from every device.
+ */
+void bt_mesh_tst_hb_discovery(uint16_t addr, bool tester);
+
+/* Per-neighbour reception statistics: packet count and RSSI min/mean/max of every test node
+ * the scanner hears. The report logs them as this node's row of the observed link matrix.
+ */
+void bt_mesh_tst_links_adv(const struct bt_le_scan_recv_info *info);
+void bt_mesh_tst_links_report(void);
+
+/* Recover the first 7 bytes (IVI/NID, CTL/TTL, SEQ, SRC) of a network PDU by removing the
+ * obfuscation. Returns false if the PDU is not for our subnet.
+ */
+bool bt_mesh_tst_net_hdr_deobfuscate(const uint8_t *pdu, size_t len, uint8_t hdr[7]);
+
+/* Relay path tracing, enabled with trace_dir. Every received network PDU with an access message
+ * is recorded in a ring buffer, written to trace_dir/trace_<device nbr>.csv by the dump.
+ */
+void bt_mesh_tst_trace_adv(const struct bt_le_scan_recv_info *info,
+			   const struct net_buf_simple *buf);
+void bt_mesh_tst_trace_dump(void);
+
+/* Advertising buffer pool high-water marks and allocation failures of this node, logged when
+ * burst probing is configured or a pool ran out.
+ */
+void bt_mesh_tst_bufs_report(void);
+
+/* Replay protection list and message cache pressure counters of this node, see mesh_cache.c */
+struct bt_mesh_tst_cache_stats {
+	uint32_t rpl_sources;	/* Sources the RPL accepted */
+	uint32_t rpl_full;	/* Rejected, no free RPL entry for a new source */
+	uint32_t rpl_replay;	/* Rejected as replays, i.e. copies evicted from the cache */
+	uint32_t relayed;	/* Network PDUs relayed */
+	uint32_t dup_relayed;	/* Relayed again after being evicted from the cache */
+};
+
+void bt_mesh_tst_cache_stats_get(struct bt_mesh_tst_cache_stats *st);
+
+/* Logged when cc_group is set, or when the RPL or message cache overflowed */
+void bt_mesh_tst_cache_report(void);
+
+/* Lifetime in seconds of the convergecast nodes, for the interferers that run with them */
+int bt_mesh_tst_cc_wait_time(void);
+
+/* Subnet partitioning by zone, enabled with zone_map. Zone N is the subnet with NetKey and AppKey
+ * index N. The tester and the zone_border nodes join every zone of the map.
+ */
+int bt_mesh_tst_zone(int dev);
+int bt_mesh_tst_zone_net_idx(int dev);
+bool bt_mesh_tst_zone_member(int dev, int idx);
+void bt_mesh_tst_zone_key(const uint8_t base[16], int idx, uint8_t key[16]);
+void bt_mesh_tst_zone_configure(uint16_t addr);
+void bt_mesh_tst_zone_report(void);
+
+/* Intra-zone, cross-zone and per-zone latency of the tester's results */
+void bt_mesh_tst_zone_results(const struct test_results *res, int total_nodes,
+			      int max_iterations);
+
+/* Simulation speed profiling, enabled with prof_period_ms. Each test phase is marked when it
+ * starts and lasts until the next one. The samples and per-phase times are logged at exit.
+ */
+void bt_mesh_tst_prof_phase(const char *name);
+void bt_mesh_tst_prof_report(void);
+
+/* Live metrics of a tester, only published when metrics_file is given. Testers announce the
+ * number of DUTs they will measure, then report every probe and every completed DUT.
+ */
+void bt_mesh_tst_metrics_plan(int duts);
+void bt_mesh_tst_metrics_probe(int64_t latency_ms, bool ok);
+void bt_mesh_tst_metrics_dut_done(void);
+void bt_mesh_tst_metrics_finish(void);
+
 #endif /* ZEPHYR_TESTS_BSIM_BT_MESH_NW_SIM_H_ */
@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Relay path tracing. Every network PDU carrying an access message that the scanner receives
+ * is deobfuscated with the privacy key of its subnet, and its source, sequence number, TTL,
+ * reception time and transmitter are stored in a fixed ring buffer. With identity addresses
+ * derived from the device number (see bt_mesh_device_setup()), the advertiser address tells
+ * which node transmitted the copy. The ring buffer is written to trace_dir/trace_<dev>.csv at
+ * exit, and helper_relay_trace.py rebuilds the flood tree of every message from all the files.
+ */
+
+#include "mesh_test.h"
+#include "native/mesh_host.h"
+
+#include <stdio.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/byteorder.h>
+#include "bs_tracing.h"
+#include "bsim_args_runner.h"
+
+#include "mesh/net.h"
+#include "mesh/subnet.h"
+#include "mesh/crypto.h"
+
+#define LOG_MODULE_NAME mesh_trace
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(LOG_MODULE_NAME);
+
+extern char *trace_dir;
+
+#define TRACE_RING_SIZE (4096)
+
+/* Earlier records searched for a copy of the same message */
+#define TRACE_DUP_WINDOW (64)
+
+/* Transmitter not known (not one of the identity addresses set in bt_mesh_device_setup()) */
+#define TRACE_TX_UNKNOWN (0xffff)
+
+/* Shortest network PDU: header, 2 byte DST, 1 byte transport PDU and 4 byte NetMIC */
+#define NET_PDU_MIN_LEN (9 + 1 + 4)
+
+struct trace_rec {
+	uint32_t time_ms;
+	uint32_t seq;
+	uint16_t src;
+	uint16_t tx;
+	uint8_t ttl;
+	bool first;
+};
+
+static struct trace_rec trace_ring[TRACE_RING_SIZE];
+static uint32_t trace_head;
+static uint32_t trace_undecoded;
+
+static bool trace_first_copy(uint16_t src, uint32_t seq)
+{
+	uint32_t n = MIN(trace_head, TRACE_DUP_WINDOW);
+
+	for (uint32_t i = 1; i <= n; i++) {
+		const struct trace_rec *rec = &trace_ring[(trace_head - i) % TRACE_RING_SIZE];
+
+		if (rec->src == src && rec->seq == seq) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static bool trace_nid_match(struct bt_mesh_subnet *sub, void *cb_data)
+{
+	const uint8_t *pdu = cb_data;
+
+	return (pdu[0] & 0x7f) == sub->keys[SUBNET_KEY_TX_IDX(sub)].msg.nid;
+}
+
+/* The PDU may belong to any subnet the node holds, e.g. the other zones of a border node (see
+ * bt_mesh_tst_zone_configure()). The subnet is picked by its NID only, without checking the
+ * NetMIC, so a PDU of a subnet whose NID collides with the first match is decoded wrongly.
+ */
+bool bt_mesh_tst_net_hdr_deobfuscate(const uint8_t *pdu, size_t len, uint8_t hdr[7])
+{
+	uint8_t copy[BT_MESH_NET_MAX_PDU_LEN];
+	uint32_t iv_index = bt_mesh.iv_index;
+	const struct bt_mesh_net_cred *cred;
+	struct bt_mesh_subnet *sub;
+
+	if (len < NET_PDU_MIN_LEN || len > sizeof(copy)) {
+		return false;
+	}
+
+	sub = bt_mesh_subnet_find(trace_nid_match, (void *)pdu);
+	if (!sub) {
+		return false;
+	}
+
+	cred = &sub->keys[SUBNET_KEY_TX_IDX(sub)].msg;
+
+	/* The IVI bit selects the current or the previous IV index */
+	if ((iv_index & 0x01) != (pdu[0] >> 7)) {
+		iv_index--;
+	}
+
+	/* Obfuscation is an XOR, applying it again restores the header */
+	memcpy(copy, pdu, len);
+	if (bt_mesh_net_obfuscate(copy, iv_index, &cred->privacy)) {
+		return false;
+	}
+
+	memcpy(hdr, copy, 7);
+	return true;
+}
+
+void bt_mesh_tst_trace_adv(const struct bt_le_scan_recv_info *info,
+			   const struct net_buf_simple *buf)
+{
+	const uint8_t *data = buf->data;
+	size_t left = buf->len;
+	struct trace_rec *rec;
+	uint8_t hdr[7];
+	int tx;
+
+	if (!trace_dir) {
+		return;
+	}
+
+	/* Find the Mesh Message AD structure */
+	while (left > 1 && data[0] && data[0] < left && data[1] != BT_DATA_MESH_MESSAGE) {
+		left -= data[0] + 1;
+		data += data[0] + 1;
+	}
+
+	if (left <= 1 || !data[0] || data[0] >= left) {
+		return;
+	}
+
+	if (!bt_mesh_tst_net_hdr_deobfuscate(&data[2], data[0] - 1, hdr)) {
+		trace_undecoded++;
+		return;
+	}
+
+	/* Control messages (heartbeats, segment acks) are not probe traffic */
+	if (hdr[1] & 0x80) {
+		return;
+	}
+
+	rec = &trace_ring[trace_head % TRACE_RING_SIZE];
+	rec->time_ms = k_uptime_get_32();
+	rec->ttl = hdr[1] & 0x7f;
+	rec->seq = sys_get_be24(&hdr[2]);
+	rec->src = sys_get_be16(&hdr[5]);
+	tx = bt_mesh_tst_id_addr_dev(info->addr);
+	rec->tx = tx < 0 ? TRACE_TX_UNKNOWN : tx;
+	rec->first = trace_first_copy(rec->src, rec->seq);
+	trace_head++;
+}
+
+void bt_mesh_tst_trace_dump(void)
+{
+	/* One CSV line is at most 40 characters */
+	static char out[TRACE_RING_SIZE * 40 + 128];
+	uint32_t n = MIN(trace_head, TRACE_RING_SIZE);
+	char path[256];
+	int off = 0;
+	int err;
+
+	if (!trace_dir) {
+		return;
+	}
+
+	off += snprintf(out + off, sizeof(out) - off, "src,seq,ttl,time_ms,tx,first\n");
+
+	for (uint32_t i = trace_head - n; i != trace_head; i++) {
+		const struct trace_rec *rec = &trace_ring[i % TRACE_RING_SIZE];
+
+		off += snprintf(out + off, sizeof(out) - off, "%u,%u,%u,%u,%d,%d\n", rec->src,
+				rec->seq, rec->ttl, rec->time_ms,
+				rec->tx == TRACE_TX_UNKNOWN ? -1 : rec->tx, rec->first);
+	}
+
+	snprintf(path, sizeof(path), "%s/trace_%d.csv", trace_dir,
+		 bsim_args_get_global_device_nbr());
+
+	err = mesh_host_write_file(path, out, MIN(off, sizeof(out) - 1));
+	if (err) {
+		LOG_ERR("Writing %s failed (err %d)", path, err);
+		return;
+	}
+
+	LOG_INF("Relay trace: %u PDUs traced, %u kept, %u not decoded, written to %s", trace_head,
+		n, trace_undecoded, path);
+}
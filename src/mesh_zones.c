@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Subnet partitioning by zone. zone_map gives the zone of every device index, and each zone is
+ * a subnet of its own: its NetKey and AppKey index equal the zone number, and the keys differ
+ * from the default ones in their second byte. Nodes only relay the subnets they have a NetKey
+ * for, so a message floods its own zone instead of the whole network. The tester and the
+ * zone_border nodes join every zone of the map. The tester reaches each DUT on the DUT's subnet,
+ * and the border nodes carry that traffic between zones. With zone_flat, all nodes stay on
+ * subnet 0 but still report their zone, which gives the single-subnet baseline of the same run.
+ */
+
+#include "mesh_test.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include "bs_tracing.h"
+#include "bsim_args_runner.h"
+
+#define LOG_MODULE_NAME mesh_zones
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(LOG_MODULE_NAME);
+
+extern int zone_map[MAX_DEVICES];
+extern int zone_count;
+extern int zone_border[MAX_DEVICES];
+extern int zone_border_count;
+extern int zone_flat;
+extern int node_count;
+
+extern uint8_t app_key[16];
+extern uint8_t net_key[16];
+extern uint8_t net_idx;
+
+/* Latency histogram resolution and range, used for the per-class percentiles */
+#define ZONE_HIST_BIN_MS (10)
+#define ZONE_HIST_BINS (500)
+
+struct zone_lat {
+	uint32_t hist[ZONE_HIST_BINS];
+	int64_t sum;
+	uint32_t answered;
+	uint32_t probes;
+	int duts;
+};
+
+int bt_mesh_tst_zone(int dev)
+{
+	return dev < zone_count ? zone_map[dev] : 0;
+}
+
+int bt_mesh_tst_zone_net_idx(int dev)
+{
+	return zone_flat ? 0 : bt_mesh_tst_zone(dev);
+}
+
+/* The tester (last node) and the border nodes join every zone */
+static bool zone_all(int dev)
+{
+	return dev == node_count - 1 ||
+	       (zone_border_count && is_dut(dev, zone_border, zone_border_count));
+}
+
+bool bt_mesh_tst_zone_member(int dev, int idx)
+{
+	if (idx == bt_mesh_tst_zone_net_idx(dev)) {
+		return true;
+	}
+
+	if (zone_flat || !zone_all(dev)) {
+		return false;
+	}
+
+	for (int i = 0; i < zone_count; i++) {
+		if (zone_map[i] == idx) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void bt_mesh_tst_zone_key(const uint8_t base[16], int idx, uint8_t key[16])
+{
+	memmove(key, base, 16);
+	key[1] = idx;
+}
+
+void bt_mesh_tst_zone_configure(uint16_t addr)
+{
+	uint8_t key[16];
+	uint8_t status;
+	int err;
+
+	for (int idx = 0; idx < CONFIG_BT_MESH_SUBNET_COUNT; idx++) {
+		if (idx == net_idx || !bt_mesh_tst_zone_member(addr - 1, idx)) {
+			continue;
+		}
+
+		bt_mesh_tst_zone_key(net_key, idx, key);
+		err = bt_mesh_cfg_cli_net_key_add(net_idx, addr, idx, key, &status);
+		if (err || status) {
+			FAIL("NetKey 0x%03x add failed (err %d, status %u)", idx, err, status);
+			return;
+		}
+
+		bt_mesh_tst_zone_key(app_key, idx, key);
+		err = bt_mesh_cfg_cli_app_key_add(net_idx, addr, idx, idx, key, &status);
+		if (err || status) {
+			FAIL("AppKey 0x%03x add failed (err %d, status %u)", idx, err, status);
+			return;
+		}
+	}
+}
+
+void bt_mesh_tst_zone_report(void)
+{
+	int dev = bsim_args_get_global_device_nbr();
+	struct bt_mesh_statistic st;
+
+	if (!zone_count) {
+		return;
+	}
+
+	bt_mesh_stat_get(&st);
+
+	LOG_INF("Zone dev %d: zone %d net %d%s, relayed %u tx %u", dev, bt_mesh_tst_zone(dev),
+		bt_mesh_tst_zone_net_idx(dev), zone_all(dev) ? " border" : "",
+		st.tx_adv_relay_planned, st.tx_local_planned + st.tx_adv_relay_planned);
+}
+
+static void zone_lat_add(struct zone_lat *lat, const struct test_results *res,
+			 int max_iterations)
+{
+	lat->duts++;
+	lat->probes += max_iterations;
+
+	/* Failed probes leave their latency at 0 */
+	for (int i = 0; i < max_iterations; i++) {
+		if (res->latency[i] > 0) {
+			lat->answered++;
+			lat->sum += res->latency[i];
+			lat->hist[MIN(res->latency[i] / ZONE_HIST_BIN_MS, ZONE_HIST_BINS - 1)]++;
+		}
+	}
+}
+
+static void zone_lat_print(const char *name, const struct zone_lat *lat)
+{
+	if (!lat->duts) {
+		return;
+	}
+
+	LOG_INF("Zone latency %s: %d DUTs, %u/%u answered, mean %lld ms p50 %u ms p95 %u ms",
+		name, lat->duts, lat->answered, lat->probes,
+		lat->answered ? lat->sum / lat->answered : -1LL,
+		bt_mesh_tst_hist_percentile(lat->hist, ZONE_HIST_BINS, ZONE_HIST_BIN_MS,
+					    lat->answered, 50),
+		bt_mesh_tst_hist_percentile(lat->hist, ZONE_HIST_BINS, ZONE_HIST_BIN_MS,
+					    lat->answered, 95));
+}
+
+void bt_mesh_tst_zone_results(const struct test_results *res, int total_nodes,
+			      int max_iterations)
+{
+	static struct zone_lat intra, cross, zones[CONFIG_BT_MESH_SUBNET_COUNT];
+	int home = bt_mesh_tst_zone(total_nodes - 1);
+	char name[16];
+
+	if (!zone_count) {
+		return;
+	}
+
+	LOG_INF("Zones: tester in zone %d, %s", home,
+		zone_flat ? "all nodes on subnet 0 (baseline)" : "one subnet per zone");
+
+	/* The tester answers itself over the local interface, leave it out */
+	for (int dut = 0; dut < total_nodes - 1; dut++) {
+		int zone = bt_mesh_tst_zone(dut);
+
+		if (!res[dut].addr) {
+			continue;
+		}
+
+		zone_lat_add(zone == home ? &intra : &cross, &res[dut], max_iterations);
+		zone_lat_add(&zones[zone], &res[dut], max_iterations);
+	}
+
+	zone_lat_print("intra-zone", &intra);
+	zone_lat_print("cross-zone", &cross);
+
+	for (int zone = 0; zone < CONFIG_BT_MESH_SUBNET_COUNT; zone++) {
+		snprintf(name, sizeof(name), "zone %d", zone);
+		zone_lat_print(name, &zones[zone]);
+	}
+}
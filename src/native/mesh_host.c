@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Built into the native simulator runner, with the host C library, so the test code can
+ * read host clocks and write files while the simulation runs. Simulated time is not involved.
+ */
+
+#include "mesh_host.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <time.h>
+#include <unistd.h>
+
+static int64_t clock_us(clockid_t clk)
+{
+	struct timespec ts;
+
+	if (clock_gettime(clk, &ts)) {
+		return 0;
+	}
+
+	return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+int64_t mesh_host_wall_time_us(void)
+{
+	return clock_us(CLOCK_MONOTONIC);
+}
+
+int64_t mesh_host_cpu_time_us(void)
+{
+	return clock_us(CLOCK_PROCESS_CPUTIME_ID);
+}
+
+int64_t mesh_host_unix_time_s(void)
+{
+	return clock_us(CLOCK_REALTIME) / 1000000;
+}
+
+int mesh_host_write_file(const char *path, const char *data, size_t len)
+{
+	char tmp[4096];
+	int fd;
+
+	/* Write next to the target and rename over it, so a scraper never sees a torn file */
+	if (snprintf(tmp, sizeof(tmp), "%s.%d.tmp", path, (int)getpid()) >= (int)sizeof(tmp)) {
+		return -ENAMETOOLONG;
+	}
+
+	fd = open(tmp, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if (fd < 0) {
+		return -errno;
+	}
+
+	while (len > 0) {
+		ssize_t n = write(fd, data, len);
+
+		if (n < 0) {
+			int err = -errno;
+
+			close(fd);
+			unlink(tmp);
+			return err;
+		}
+
+		data += n;
+		len -= n;
+	}
+
+	close(fd);
+
+	if (rename(tmp, path)) {
+		int err = -errno;
+
+		unlink(tmp);
+		return err;
+	}
+
+	return 0;
+}
@@ -0,0 +1,29 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Host (runner side) services for the test code, see mesh_host.c */
+
+#ifndef ZEPHYR_TESTS_BSIM_BT_MESH_NW_SIM_HOST_H_
+#define ZEPHYR_TESTS_BSIM_BT_MESH_NW_SIM_HOST_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Host monotonic wall-clock time in microseconds */
+int64_t mesh_host_wall_time_us(void);
+
+/* Host CPU time consumed by this device process so far, in microseconds */
+int64_t mesh_host_cpu_time_us(void);
+
+/* Host calendar time in seconds since the Unix epoch */
+int64_t mesh_host_unix_time_s(void);
+
+/* Replace the content of the file at path. Readers never see a partially written file.
+ * Returns 0 on success or a negative errno value.
+ */
+int mesh_host_write_file(const char *path, const char *data, size_t len);
+
+#endif /* ZEPHYR_TESTS_BSIM_BT_MESH_NW_SIM_HOST_H_ */
@@ -18,6 +18,11 @@ echo "Using network coefficient file: $COEFF_FILE_PATH"
 if [[ -n "$DUT_LIST" ]]; then
   echo "Testing specific DUTs: $DUT_LIST"
 fi
+if [ "$INTERFERERS" -gt 0 ]; then
+  echo "Adding $INTERFERERS $INTF_MODE interferers (duty $INTF_DUTY% of $INTF_PERIOD ms)"
+  # Interferers last as long as the vendor model devices
+  export EXTRA_DEVS_TESTID="vnd_node_interferer"
+fi
 
 node_array=($(printf "vnd_node_device %.0s" $(seq 2 $NODE_COUNT)) "vnd_node_tester")
-RunTest nodump arg_ch=multiatt arg_file="$COEFF_FILE_PATH" mesh_nw_sim_test "${node_array[@]}" -- -argstest iterations="$MAX_ITERATIONS" duts="$DUT_LIST"
+RunTest nodump arg_ch=multiatt arg_file="$COEFF_FILE_PATH" mesh_nw_sim_test "${node_array[@]}" -- -argstest "${TEST_ARGS[@]}"
@@ -19,6 +19,9 @@ echo "Using network coefficient file: $COEFF_FILE_PATH"
 if [[ -n "$DUT_LIST" ]]; then
   echo "Testing specific DUTs: $DUT_LIST"
 fi
+if [ "$INTERFERERS" -gt 0 ]; then
+  echo "Adding $INTERFERERS $INTF_MODE interferers (duty $INTF_DUTY% of $INTF_PERIOD ms)"
+fi
 
 node_array=($(printf "node_device %.0s" $(seq 2 $NODE_COUNT)) "node_tester")
-RunTest arg_ch=multiatt arg_file="$COEFF_FILE_PATH" mesh_nw_sim_test "${node_array[@]}" -- -argstest iterations="$MAX_ITERATIONS" duts="$DUT_LIST"
+RunTest arg_ch=multiatt arg_file="$COEFF_FILE_PATH" mesh_nw_sim_test "${node_array[@]}" -- -argstest "${TEST_ARGS[@]}"
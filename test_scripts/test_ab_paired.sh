@@ -0,0 +1,107 @@
+#!/usr/bin/env bash
+# Copyright 2025 Nordic Semiconductor
+# SPDX-License-Identifier: Apache-2.0
+
+# Paired A/B comparison: runs configuration A and configuration B once per seed, with the same
+# seeds on both sides, then reports the paired latency differences with helper_ab_compare.py.
+# Both sides see the same random sequences (common random numbers), so the run-to-run noise
+# mostly cancels out in the differences and far fewer iterations are needed to detect a change.
+#
+# A configuration is an optional build overlay (the same as the "overlay" variable of RunTest)
+# and optional extra test script options. Everything after "--" is passed to both sides.
+#
+# Examples of use:
+# ./test_scripts/test_ab_paired.sh --seeds 1,2,3,4,5 --b-args "--quiet-ms 300" -- \
+#     -n 10 -c network1_att_file.coeff -i 10
+# ./test_scripts/test_ab_paired.sh --seeds 1,2,3 --b-overlay overlay_relay_off -- \
+#     -n 24 -c network2_att_file.coeff -i 5
+
+SCRIPT_DIR="$(cd -- "$(dirname -- "${BASH_SOURCE[0]}")" &> /dev/null && pwd)"
+
+SEEDS="1,2,3,4,5"
+TEST_SCRIPT="test_1tester_ndevs_generic.sh"
+A_OVERLAY=""
+B_OVERLAY=""
+A_ARGS=""
+B_ARGS=""
+OUT_DIR="${BSIM_OUT_PATH:-.}/results/ab_$(date +%Y%m%d_%H%M%S)"
+
+function show_usage() {
+  echo "Usage: $0 [OPTIONS] -- TEST_OPTIONS"
+  echo "Options:"
+  echo "  --seeds LIST          Comma-separated run seeds, one paired run each (default: 1,2,3,4,5)"
+  echo "  --script NAME         Test script in test_scripts/ to run (default: $TEST_SCRIPT)"
+  echo "  --a-overlay NAME      Build overlay of configuration A (default: none)"
+  echo "  --b-overlay NAME      Build overlay of configuration B (default: none)"
+  echo "  --a-args \"OPTS\"       Extra test script options of configuration A"
+  echo "  --b-args \"OPTS\"       Extra test script options of configuration B"
+  echo "  --out DIR             Directory for the logs (default: \$BSIM_OUT_PATH/results/ab_<date>)"
+  echo "  -h, --help            Show this help message"
+  echo "TEST_OPTIONS are passed to both configurations, e.g. -n 10 -c network1_att_file.coeff"
+  exit 1
+}
+
+while [[ $# -gt 0 ]]; do
+  case $1 in
+    --seeds) SEEDS="$2"; shift 2 ;;
+    --script) TEST_SCRIPT="$2"; shift 2 ;;
+    --a-overlay) A_OVERLAY="$2"; shift 2 ;;
+    --b-overlay) B_OVERLAY="$2"; shift 2 ;;
+    --a-args) A_ARGS="$2"; shift 2 ;;
+    --b-args) B_ARGS="$2"; shift 2 ;;
+    --out) OUT_DIR="$2"; shift 2 ;;
+    --) shift; break ;;
+    -h|--help) show_usage ;;
+    *) echo "Error: Unknown option: $1"; show_usage ;;
+  esac
+done
+
+COMMON_ARGS=("$@")
+
+if ! [[ "$SEEDS" =~ ^[0-9,]+$ ]]; then
+  echo "Error: Seeds must be a comma-separated list of numbers. Got: '$SEEDS'"
+  exit 1
+fi
+
+if [[ ! -x "${SCRIPT_DIR}/${TEST_SCRIPT}" ]]; then
+  echo "Error: Test script '${TEST_SCRIPT}' not found in ${SCRIPT_DIR}"
+  exit 1
+fi
+
+if [[ "$A_OVERLAY" == "$B_OVERLAY" && "$A_ARGS" == "$B_ARGS" ]]; then
+  echo "Warning: configurations A and B are identical, all differences should be zero"
+fi
+
+mkdir -p "${OUT_DIR}/A" "${OUT_DIR}/B"
+echo "A: overlay '${A_OVERLAY}' args '${A_ARGS}'" | tee "${OUT_DIR}/configs.txt"
+echo "B: overlay '${B_OVERLAY}' args '${B_ARGS}'" | tee -a "${OUT_DIR}/configs.txt"
+echo "Common: ${COMMON_ARGS[*]}" | tee -a "${OUT_DIR}/configs.txt"
+
+failed=0
+IFS=',' read -ra SEED_LIST <<< "$SEEDS"
+for seed in "${SEED_LIST[@]}"; do
+  for side in A B; do
+    if [[ "$side" == "A" ]]; then
+      side_overlay="$A_OVERLAY"
+      side_args="$A_ARGS"
+    else
+      side_overlay="$B_OVERLAY"
+      side_args="$B_ARGS"
+    fi
+
+    log="${OUT_DIR}/${side}/seed_${seed}.log"
+    echo "Running configuration ${side} with seed ${seed} (log: ${log})"
+
+    # side_args is split on purpose, it holds several options
+    overlay="$side_overlay" "${SCRIPT_DIR}/${TEST_SCRIPT}" "${COMMON_ARGS[@]}" ${side_args} \
+      --seed "$seed" > "$log" 2>&1
+    if [ $? -ne 0 ]; then
+      echo "Configuration ${side} with seed ${seed} failed, see ${log}"
+      failed=1
+    fi
+  done
+done
+
+python3 "${SCRIPT_DIR}/../helper_ab_compare.py" "${OUT_DIR}/A" "${OUT_DIR}/B"
+
+exit $failed
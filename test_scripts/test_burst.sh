@@ -0,0 +1,32 @@
+#!/usr/bin/env bash
+# Copyright 2025 Nordic Semiconductor
+# SPDX-License-Identifier: Apache-2.0
+
+# Burst probing: the tester sends K requests back-to-back, to one DUT at a time (dut), to the
+# DUTs in turn (multi) or to a group all DUTs subscribe to (group). Each entry of --burst-sizes
+# is one measurement phase. Every node reports its advertising buffer high-water marks and
+# allocation failures at exit, see helper_buf_usage.py.
+#
+# Examples of use:
+# ./test_scripts/test_burst.sh -n 10 -c network1_att_file.coeff -i 5 --burst-sizes "1,2,4,8,16"
+# ./test_scripts/test_burst.sh -n 24 -c network2_att_file.coeff -i 5 --burst-mode group -d 3,7,15
+
+source $(dirname "${BASH_SOURCE[0]}")/../_mesh_test.sh
+source $(dirname "${BASH_SOURCE[0]}")/test_common.sh
+parse_args "${BASH_SOURCE[0]}" "$@"
+
+if ! [[ "$BURST_SIZES" =~ ^[0-9,]+$ ]]; then
+  echo "Error: Burst sizes must be a comma-separated list of numbers. Got: '$BURST_SIZES'"
+  exit 1
+fi
+
+TEST_ARGS+=(burst_sizes="$BURST_SIZES")
+
+# Note: In all test scenarios, tester node must be kept at the end so that tester
+# knows the number of devices in the network.
+echo "Running test with $NODE_COUNT (devices and tester) nodes."
+echo "Using network coefficient file: $COEFF_FILE_PATH"
+echo "Burst sizes: $BURST_SIZES, mode $BURST_MODE"
+
+node_array=($(printf "node_device %.0s" $(seq 2 $NODE_COUNT)) "node_burst_tester")
+RunTest nodump arg_ch=multiatt arg_file="$COEFF_FILE_PATH" mesh_nw_sim_test "${node_array[@]}" -- -argstest "${TEST_ARGS[@]}"
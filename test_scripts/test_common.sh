@@ -7,6 +7,35 @@ NODE_COUNT=""
 COEFF_FILE=""
 MAX_ITERATIONS="10"  # Default value for iterations
 DUT_LIST=""         # List of DUTs to test
+QUIET_MS="150"       # Idle window without mesh traffic before the next probe
+QUIET_MAX_MS="2500"  # Upper bound on the wait for a quiet network
+INTERFERERS="0"      # Number of non-mesh background interferers
+INTF_MODE="adv_legacy"
+INTF_INTERVAL="100"
+INTF_PERIOD="1000"
+INTF_DUTY="100"
+INTF_LEN="31"
+PROXY_NODE="-1"      # Only this device index acts as GATT proxy (-1: all devices)
+CONN_INT="0"         # Proxy client connection interval in ms (0: stack default)
+CC_PERIODS="5000"    # Convergecast report period per source, one per load phase
+CC_PHASE_MS="30000"  # Duration of each convergecast load phase
+CC_JITTER="100"      # Random delay added to each convergecast report
+CC_LEN="8"           # Convergecast report length (above 8 bytes reports are segmented)
+CC_GROUP="0"         # Convergecast reports go to a group all nodes subscribe to (1) or the sink (0)
+BURST_SIZES="1,2,4,8" # Requests per burst, one measurement phase each (burst tester only)
+BURST_MODE="dut"     # Burst targets: dut, multi or group
+HB_SLOT="0"          # Heartbeat hop discovery slot per node in ms (0: no discovery)
+HB_COUNT="1"         # Heartbeats per node during the discovery
+METRICS_FILE=""      # Live progress metrics written by the tester (Prometheus text format)
+METRICS_PERIOD="10000"
+TRACE_DIR=""         # Every node writes its relay path trace here at exit
+LINKS="0"            # Run the identity address build, so nodes report the links they observe
+ZONE_MAP=""          # Zone (subnet) of each device index (empty: all nodes on one subnet)
+ZONE_BORDER=""       # Device indices that join every zone and relay between them
+ZONE_FLAT="0"        # Keep all nodes on one subnet but report the zones (baseline)
+PROF_PERIOD="0"      # Simulation speed profiling sample period in ms (0: off)
+RESYNC_US="100000"   # Maximum simulated time drift between devices before resyncing
+RUN_SEED="${RUN_SEED:-}" # Seed all device and phy seeds are derived from (default: bsim defaults)
 
 # Usage information
 function show_usage() {
@@ -20,6 +49,36 @@ function show_usage() {
   echo "  -i, --iterations NUM  Number of iterations for the test (default: 10)"
   echo "  -d, --duts LIST      Comma-separated list of DUT indices to test (e.g., \"0,2,5,6\")"
   echo "                       If not specified, all nodes except tester will be tested"
+  echo "  -q, --quiet-ms MS     Idle time without mesh traffic before next probe (default: 150)"
+  echo "  --quiet-max-ms MS     Maximum wait for a quiet network between probes (default: 2500)"
+  echo "  --interferers NUM     Number of non-mesh interferers placed after the tester (default: 0)"
+  echo "                       (Note: The coefficient file must contain their positions)"
+  echo "  --intf-mode MODE      Interferer role: adv_legacy, adv_ext or scan (default: adv_legacy)"
+  echo "  --intf-interval MS    Interferer advertising/scan interval (default: 100)"
+  echo "  --intf-period MS      Interferer on/off cycle length (default: 1000)"
+  echo "  --intf-duty PCT       Percentage of each cycle the interferers are active (default: 100)"
+  echo "  --intf-len BYTES      Interferer advertising data length (default: 31)"
+  echo "  -p, --proxy-node IDX  Device index of the GATT proxy used by a proxy client tester"
+  echo "  --conn-int MS         Connection interval requested by the proxy client (default: stack default)"
+  echo "  --cc-periods LIST     Convergecast report periods in ms, one load phase each (default: 5000)"
+  echo "  --cc-phase-ms MS      Duration of each convergecast load phase (default: 30000)"
+  echo "  --cc-jitter MS        Random delay added to each convergecast report (default: 100)"
+  echo "  --cc-len BYTES        Convergecast report length, segmented above 8 (default: 8)"
+  echo "  --cc-group            Send convergecast reports to a group all nodes subscribe to"
+  echo "  --burst-sizes LIST    Back-to-back requests per burst, one phase each (default: 1,2,4,8)"
+  echo "  --burst-mode MODE     Burst targets: dut (one DUT), multi (DUTs in turn) or group (default: dut)"
+  echo "  --hb-discovery MS     Discover hop counts with heartbeats first, MS per node (e.g. 500)"
+  echo "  --hb-count NUM        Heartbeats per node during the discovery: 1, 2, 4 or 8 (default: 1)"
+  echo "  --metrics FILE        Tester writes live progress metrics to FILE (Prometheus text format)"
+  echo "  --metrics-period MS   Simulated time between metrics updates (default: 10000)"
+  echo "  --trace DIR           Every node writes a relay path trace to DIR (see helper_relay_trace.py)"
+  echo "  --links               Every node reports the links it observes (see helper_link_matrix.py)"
+  echo "  --zone-map LIST       Comma-separated zone (subnet 0-4) of each device index, tester last"
+  echo "  --zone-border LIST    Comma-separated device indices that join every zone"
+  echo "  --zone-flat           Keep all nodes on one subnet but report the zones (baseline)"
+  echo "  --profile MS          Profile simulation speed, sampling every MS of simulated time (e.g. 5000)"
+  echo "  --resync-us US        Maximum simulated time drift between devices (default: 100000)"
+  echo "  --seed NUM            Run seed, derives the seeds of all devices and the phy (0-2147483646)"
   echo "  -h, --help            Show this help message"
   exit 1
 }
@@ -48,6 +107,122 @@ function parse_args() {
         DUT_LIST="$2"
         shift 2
         ;;
+      -q|--quiet-ms)
+        QUIET_MS="$2"
+        shift 2
+        ;;
+      --quiet-max-ms)
+        QUIET_MAX_MS="$2"
+        shift 2
+        ;;
+      --interferers)
+        INTERFERERS="$2"
+        shift 2
+        ;;
+      --intf-mode)
+        INTF_MODE="$2"
+        shift 2
+        ;;
+      --intf-interval)
+        INTF_INTERVAL="$2"
+        shift 2
+        ;;
+      --intf-period)
+        INTF_PERIOD="$2"
+        shift 2
+        ;;
+      --intf-duty)
+        INTF_DUTY="$2"
+        shift 2
+        ;;
+      --intf-len)
+        INTF_LEN="$2"
+        shift 2
+        ;;
+      -p|--proxy-node)
+        PROXY_NODE="$2"
+        shift 2
+        ;;
+      --conn-int)
+        CONN_INT="$2"
+        shift 2
+        ;;
+      --cc-periods)
+        CC_PERIODS="$2"
+        shift 2
+        ;;
+      --cc-phase-ms)
+        CC_PHASE_MS="$2"
+        shift 2
+        ;;
+      --cc-jitter)
+        CC_JITTER="$2"
+        shift 2
+        ;;
+      --cc-len)
+        CC_LEN="$2"
+        shift 2
+        ;;
+      --cc-group)
+        CC_GROUP="1"
+        shift
+        ;;
+      --burst-sizes)
+        BURST_SIZES="$2"
+        shift 2
+        ;;
+      --burst-mode)
+        BURST_MODE="$2"
+        shift 2
+        ;;
+      --hb-discovery)
+        HB_SLOT="$2"
+        shift 2
+        ;;
+      --hb-count)
+        HB_COUNT="$2"
+        shift 2
+        ;;
+      --metrics)
+        METRICS_FILE="$2"
+        shift 2
+        ;;
+      --metrics-period)
+        METRICS_PERIOD="$2"
+        shift 2
+        ;;
+      --trace)
+        TRACE_DIR="$2"
+        shift 2
+        ;;
+      --links)
+        LINKS="1"
+        shift
+        ;;
+      --zone-map)
+        ZONE_MAP="$2"
+        shift 2
+        ;;
+      --zone-border)
+        ZONE_BORDER="$2"
+        shift 2
+        ;;
+      --zone-flat)
+        ZONE_FLAT="1"
+        shift
+        ;;
+      --profile)
+        PROF_PERIOD="$2"
+        shift 2
+        ;;
+      --resync-us)
+        RESYNC_US="$2"
+        shift 2
+        ;;
+      --seed)
+        RUN_SEED="$2"
+        shift 2
+        ;;
       -h|--help)
         show_usage
         ;;
@@ -82,6 +257,13 @@ function parse_args() {
     exit 1
   fi
 
+  # Validate pacing parameters
+  if ! [[ "$QUIET_MS" =~ ^[0-9]+$ && "$QUIET_MAX_MS" =~ ^[0-9]+$ ]] || \
+     [ "$QUIET_MAX_MS" -lt "$QUIET_MS" ]; then
+    echo "Error: Quiet window must be 0 <= quiet-ms <= quiet-max-ms. Got: '$QUIET_MS' '$QUIET_MAX_MS'"
+    exit 1
+  fi
+
   # Validate DUT_LIST if provided, otherwise generate it
   max_allowed=$((NODE_COUNT - 1))
   if [[ -n "$DUT_LIST" ]]; then
@@ -103,4 +285,98 @@ function parse_args() {
     # If DUT_LIST is not provided, generate it automatically (all nodes except tester)
     DUT_LIST=$(seq -s, 0 $((max_allowed)))
   fi
+
+  if [[ "$PROXY_NODE" != "-1" ]] && \
+     ! ([[ "$PROXY_NODE" =~ ^[0-9]+$ ]] && [ "$PROXY_NODE" -lt "$max_allowed" ]); then
+    echo "Error: Proxy node index must be between 0 and $((max_allowed - 1)). Got: '$PROXY_NODE'"
+    exit 1
+  fi
+
+  if ! [[ "$CC_PERIODS" =~ ^[0-9,]+$ ]]; then
+    echo "Error: Convergecast periods must be a comma-separated list of numbers. Got: '$CC_PERIODS'"
+    exit 1
+  fi
+
+  # Interferers occupy the phy slots after the tester
+  if ! [[ "$INTERFERERS" =~ ^[0-9]+$ ]]; then
+    echo "Error: Interferer count must be a non-negative integer. Got: '$INTERFERERS'"
+    exit 1
+  fi
+  if [ "$INTERFERERS" -gt 0 ]; then
+    export EXTRA_DEVS=$INTERFERERS
+    export EXTRA_DEVS_TESTID="node_interferer"
+  fi
+
+  # Test arguments passed to every device after -argstest
+  TEST_ARGS=(
+    iterations="$MAX_ITERATIONS"
+    duts="$DUT_LIST"
+    quiet_ms="$QUIET_MS"
+    quiet_max_ms="$QUIET_MAX_MS"
+    intf_mode="$INTF_MODE"
+    intf_interval_ms="$INTF_INTERVAL"
+    intf_period_ms="$INTF_PERIOD"
+    intf_duty="$INTF_DUTY"
+    intf_len="$INTF_LEN"
+    proxy_node="$PROXY_NODE"
+    proxy_conn_int_ms="$CONN_INT"
+    cc_periods="$CC_PERIODS"
+    cc_phase_ms="$CC_PHASE_MS"
+    cc_jitter_ms="$CC_JITTER"
+    cc_len="$CC_LEN"
+    cc_sink="$((NODE_COUNT - 1))"
+    cc_group="$CC_GROUP"
+    burst_mode="$BURST_MODE"
+    metrics_period_ms="$METRICS_PERIOD"
+    nodes="$NODE_COUNT"
+    hb_slot_ms="$HB_SLOT"
+    hb_count="$HB_COUNT"
+    prof_period_ms="$PROF_PERIOD"
+    resync_us="$RESYNC_US"
+  )
+
+  # RunTest derives the process seeds from RUN_SEED, the devices only record it
+  if [[ -n "$RUN_SEED" ]]; then
+    if ! [[ "$RUN_SEED" =~ ^[0-9]+$ ]] || [ "$RUN_SEED" -ge 2147483647 ]; then
+      echo "Error: Seed must be an integer between 0 and 2147483646. Got: '$RUN_SEED'"
+      exit 1
+    fi
+    export RUN_SEED
+    TEST_ARGS+=(run_seed="$RUN_SEED")
+  fi
+
+  # Devices run from ${BSIM_OUT_PATH}/bin, so the metrics file path must be absolute
+  if [[ -n "$METRICS_FILE" ]]; then
+    TEST_ARGS+=(metrics_file="$(realpath -m "$METRICS_FILE")")
+  fi
+
+  if [[ -n "$ZONE_MAP" ]]; then
+    if ! [[ "$ZONE_MAP" =~ ^[0-4](,[0-4])*$ ]]; then
+      echo "Error: Zone map must be a comma-separated list of zones 0-4. Got: '$ZONE_MAP'"
+      exit 1
+    fi
+    if ! [[ "$ZONE_BORDER" =~ ^[0-9,]*$ ]]; then
+      echo "Error: Zone border nodes must be a comma-separated list of numbers. Got: '$ZONE_BORDER'"
+      exit 1
+    fi
+    TEST_ARGS+=(zone_map="$ZONE_MAP" zone_flat="$ZONE_FLAT")
+    if [[ -n "$ZONE_BORDER" ]]; then
+      TEST_ARGS+=(zone_border="$ZONE_BORDER")
+    fi
+  fi
+
+  if [[ -n "$TRACE_DIR" ]]; then
+    mkdir -p "$TRACE_DIR" || exit 1
+    TEST_ARGS+=(trace_dir="$(realpath "$TRACE_DIR")")
+  fi
+
+  # Tracing and the link matrix tell transmitters apart by their identity address, which only
+  # the overlay_id_addr.conf build advertises with (see compile.sh)
+  if [[ -n "$TRACE_DIR" || "$LINKS" == "1" ]]; then
+    if [[ -n "${overlay:-}" && "$overlay" != "overlay_id_addr_conf" ]]; then
+      echo "Error: --trace and --links need the overlay_id_addr_conf build, not '$overlay'"
+      exit 1
+    fi
+    overlay="overlay_id_addr_conf"
+  fi
 }
\ No newline at end of file
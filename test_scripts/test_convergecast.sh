@@ -0,0 +1,28 @@
+#!/usr/bin/env bash
+# Copyright 2025 Nordic Semiconductor
+# SPDX-License-Identifier: Apache-2.0
+
+# Many-to-one scenario: every DUT periodically reports to the last node (the sink). Each entry
+# of --cc-periods is one load phase, so a decreasing list sweeps the offered load in one run.
+#
+# Examples of use:
+# ./test_scripts/test_convergecast.sh -n 24 -c network2_att_file.coeff --cc-periods "8000,4000,2000,1000"
+# ./test_scripts/test_convergecast.sh -n 10 -c network1_att_file.coeff --cc-periods "4000,2000" --cc-len 30
+
+source $(dirname "${BASH_SOURCE[0]}")/../_mesh_test.sh
+source $(dirname "${BASH_SOURCE[0]}")/test_common.sh
+parse_args "${BASH_SOURCE[0]}" "$@"
+
+# Note: In all test scenarios, the sink node must be kept at the end so that it knows the
+# number of devices in the network.
+echo "Running test with $NODE_COUNT (sources and sink) nodes."
+echo "Using network coefficient file: $COEFF_FILE_PATH"
+echo "Report periods per phase: $CC_PERIODS ms, $CC_PHASE_MS ms per phase, $CC_LEN byte reports"
+if [ "$INTERFERERS" -gt 0 ]; then
+  echo "Adding $INTERFERERS $INTF_MODE interferers (duty $INTF_DUTY% of $INTF_PERIOD ms)"
+  # Interferers last as long as the convergecast nodes
+  export EXTRA_DEVS_TESTID="cc_node_interferer"
+fi
+
+node_array=($(printf "cc_node_device %.0s" $(seq 2 $NODE_COUNT)) "cc_node_sink")
+RunTest nodump arg_ch=multiatt arg_file="$COEFF_FILE_PATH" mesh_nw_sim_test "${node_array[@]}" -- -argstest "${TEST_ARGS[@]}"
@@ -0,0 +1,28 @@
+#!/usr/bin/env bash
+# Copyright 2025 Nordic Semiconductor
+# SPDX-License-Identifier: Apache-2.0
+
+# Measures round-trip latency to each DUT first over the advertising bearer, then with the
+# tester entering the mesh as a GATT proxy client connected to the given proxy node.
+#
+# Examples of use:
+# ./test_scripts/test_proxy_ingress.sh -n 10 -c network1_att_file.coeff -i 10 -p 8
+# ./test_scripts/test_proxy_ingress.sh -n 24 -c network2_att_file.coeff -i 10 -p 20 --conn-int 50
+
+source $(dirname "${BASH_SOURCE[0]}")/../_mesh_test.sh
+source $(dirname "${BASH_SOURCE[0]}")/test_common.sh
+parse_args "${BASH_SOURCE[0]}" "$@"
+
+if [[ "$PROXY_NODE" == "-1" ]]; then
+  echo "Error: A proxy node (-p) is required for this test."
+  show_usage
+fi
+
+# Note: In all test scenarios, tester node must be kept at the end so that tester
+# knows the number of devices in the network.
+echo "Running test with $NODE_COUNT (devices and tester) nodes."
+echo "Using network coefficient file: $COEFF_FILE_PATH"
+echo "Proxy client connects to device $PROXY_NODE"
+
+node_array=($(printf "node_device %.0s" $(seq 2 $NODE_COUNT)) "node_proxy_tester")
+RunTest nodump arg_ch=multiatt arg_file="$COEFF_FILE_PATH" mesh_nw_sim_test "${node_array[@]}" -- -argstest "${TEST_ARGS[@]}"
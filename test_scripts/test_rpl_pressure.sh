@@ -0,0 +1,76 @@
+#!/usr/bin/env bash
+# Copyright 2025 Nordic Semiconductor
+# SPDX-License-Identifier: Apache-2.0
+
+# Replay protection list and message cache pressure: runs the group convergecast scenario once
+# per network size, so the number of distinct sources every node must track grows past
+# CONFIG_BT_MESH_CRPL and the flood rate past CONFIG_BT_MESH_MSG_CACHE_SIZE. Each entry of
+# --cc-periods raises the flood rate within a run. helper_cache_pressure.py then reports
+# delivery, latency, RPL rejections, duplicate relays and transmitted PDUs per size and phase.
+#
+# The topology file must hold at least the largest size, network4_att_file.coeff has 100 nodes
+# (Topology 4 of helper_nw_att_file_creator.py). Sizes are limited by MAX_DEVICES
+# (src/mesh_test.h). Everything after "--" is passed to test_convergecast.sh.
+#
+# Examples of use:
+# ./test_scripts/test_rpl_pressure.sh --sizes 32,64,96 -- -c network4_att_file.coeff \
+#     --cc-periods "8000,4000,2000"
+# ./test_scripts/test_rpl_pressure.sh --sizes 48,80 --overlay overlay_crpl_128_conf -- \
+#     -c network4_att_file.coeff --cc-periods "4000,2000" --cc-phase-ms 20000
+
+SCRIPT_DIR="$(cd -- "$(dirname -- "${BASH_SOURCE[0]}")" &> /dev/null && pwd)"
+
+SIZES="16,32,48,64,80,96"
+OVERLAY=""
+OUT_DIR="${BSIM_OUT_PATH:-.}/results/rpl_$(date +%Y%m%d_%H%M%S)"
+
+function show_usage() {
+  echo "Usage: $0 [OPTIONS] -- CONVERGECAST_OPTIONS"
+  echo "Options:"
+  echo "  --sizes LIST          Comma-separated network sizes, one run each (default: $SIZES)"
+  echo "  --overlay NAME        Build overlay to run, e.g. overlay_crpl_128_conf (default: none)"
+  echo "  --out DIR             Directory for the logs (default: \$BSIM_OUT_PATH/results/rpl_<date>)"
+  echo "  -h, --help            Show this help message"
+  echo "CONVERGECAST_OPTIONS are passed to every run, e.g. -c network4_att_file.coeff"
+  exit 1
+}
+
+while [[ $# -gt 0 ]]; do
+  case $1 in
+    --sizes) SIZES="$2"; shift 2 ;;
+    --overlay) OVERLAY="$2"; shift 2 ;;
+    --out) OUT_DIR="$2"; shift 2 ;;
+    --) shift; break ;;
+    -h|--help) show_usage ;;
+    *) echo "Error: Unknown option: $1"; show_usage ;;
+  esac
+done
+
+COMMON_ARGS=("$@")
+
+if ! [[ "$SIZES" =~ ^[0-9,]+$ ]]; then
+  echo "Error: Sizes must be a comma-separated list of numbers. Got: '$SIZES'"
+  exit 1
+fi
+
+mkdir -p "${OUT_DIR}"
+echo "Sizes: ${SIZES}, overlay '${OVERLAY}'" | tee "${OUT_DIR}/config.txt"
+echo "Common: ${COMMON_ARGS[*]}" | tee -a "${OUT_DIR}/config.txt"
+
+failed=0
+IFS=',' read -ra SIZE_LIST <<< "$SIZES"
+for size in "${SIZE_LIST[@]}"; do
+  log="${OUT_DIR}/n_${size}.log"
+  echo "Running ${size} nodes (log: ${log})"
+
+  overlay="$OVERLAY" "${SCRIPT_DIR}/test_convergecast.sh" "${COMMON_ARGS[@]}" -n "$size" \
+    --cc-group > "$log" 2>&1
+  if [ $? -ne 0 ]; then
+    echo "Run with ${size} nodes failed, see ${log}"
+    failed=1
+  fi
+done
+
+python3 "${SCRIPT_DIR}/../helper_cache_pressure.py" "${OUT_DIR}"/n_*.log
+
+exit $failed
@@ -0,0 +1,74 @@
+#!/usr/bin/env bash
+# Copyright 2025 Nordic Semiconductor
+# SPDX-License-Identifier: Apache-2.0
+
+# Subnet partitioning: runs the latency test twice with the same seed, once with all nodes on
+# one subnet (the baseline, --zone-flat) and once with one subnet per zone of --zone-map. Then
+# helper_zone_compare.py compares intra-zone and cross-zone latency and the relay load per node.
+#
+# Everything after "--" is passed to both runs and must include --zone-map, the zone of each
+# device index with the tester last. --zone-border lists the nodes that join every zone and
+# relay between them; the tester always joins every zone.
+#
+# Examples of use:
+# ./test_scripts/test_zones.sh -- -n 24 -c network2_att_file.coeff -i 5 \
+#     --zone-map "0,0,0,0,0,0,0,0,1,1,1,1,1,1,1,1,2,2,2,2,2,2,2,0" --zone-border 7,15
+# ./test_scripts/test_zones.sh --seed 7 -- -n 10 -c network1_att_file.coeff -i 10 \
+#     --zone-map "0,0,0,0,0,1,1,1,1,0" --zone-border 4
+
+SCRIPT_DIR="$(cd -- "$(dirname -- "${BASH_SOURCE[0]}")" &> /dev/null && pwd)"
+
+SEED="1"
+OUT_DIR="${BSIM_OUT_PATH:-.}/results/zones_$(date +%Y%m%d_%H%M%S)"
+
+function show_usage() {
+  echo "Usage: $0 [OPTIONS] -- TEST_OPTIONS"
+  echo "Options:"
+  echo "  --seed NUM            Run seed of both runs (default: 1)"
+  echo "  --out DIR             Directory for the logs (default: \$BSIM_OUT_PATH/results/zones_<date>)"
+  echo "  -h, --help            Show this help message"
+  echo "TEST_OPTIONS are passed to both runs and must include --zone-map"
+  exit 1
+}
+
+while [[ $# -gt 0 ]]; do
+  case $1 in
+    --seed) SEED="$2"; shift 2 ;;
+    --out) OUT_DIR="$2"; shift 2 ;;
+    --) shift; break ;;
+    -h|--help) show_usage ;;
+    *) echo "Error: Unknown option: $1"; show_usage ;;
+  esac
+done
+
+COMMON_ARGS=("$@")
+
+if ! [[ " ${COMMON_ARGS[*]} " =~ " --zone-map " ]]; then
+  echo "Error: --zone-map is required after --"
+  show_usage
+fi
+
+mkdir -p "${OUT_DIR}"
+echo "Seed: ${SEED}" | tee "${OUT_DIR}/config.txt"
+echo "Common: ${COMMON_ARGS[*]}" | tee -a "${OUT_DIR}/config.txt"
+
+failed=0
+for side in baseline zoned; do
+  log="${OUT_DIR}/${side}.log"
+  side_args=()
+  if [[ "$side" == "baseline" ]]; then
+    side_args=(--zone-flat)
+  fi
+
+  echo "Running ${side} (log: ${log})"
+  "${SCRIPT_DIR}/test_1tester_ndevs_generic.sh" "${COMMON_ARGS[@]}" "${side_args[@]}" \
+    --seed "$SEED" > "$log" 2>&1
+  if [ $? -ne 0 ]; then
+    echo "Run ${side} failed, see ${log}"
+    failed=1
+  fi
+done
+
+python3 "${SCRIPT_DIR}/../helper_zone_compare.py" "${OUT_DIR}/baseline.log" "${OUT_DIR}/zoned.log"
+
+exit $failed